@@ -0,0 +1,80 @@
+/***********************************************************************
+ * Source File:
+ *    Bench Capture : Record a scenario without a window
+ * Author:
+ *    Emilio Regino, Bradley Payne, Penelope Sanchez
+ * Summary:
+ *    A standalone program that steps the simulator as fast as it can,
+ *    paints every frame offscreen, and records it, then says how many
+ *    times faster than real time that was. Build it with everything
+ *    but the other programs holding a main():
+ *       g++ -O2 -pthread benchCapture.cpp <the other sources> -lGL -lglut
+ *    and run it as
+ *       benchCapture out.y4m [frames [workers]]
+ *    or, for a run of pictures out000000.ppm, out000001.ppm, ...
+ *       benchCapture out [frames [workers]]
+ ************************************************************************/
+
+#include "simulator.h"      // for SIMULATOR
+#include "frameCapture.h"   // for FRAME CAPTURE
+#include "uiDraw.h"         // for SET RENDERER
+#include "constants.h"      // for FRAME_RATE
+#include <chrono>           // for STEADY_CLOCK
+#include <iostream>         // for COUT
+#include <string>           // for STRING
+#include <cstdlib>          // for ATOI
+using namespace std;
+
+double Position::metersFromPixels = 40.0;
+
+const int WIDTH = 1000;
+const int HEIGHT = 1000;
+
+/*************************************************************************
+ * MAIN
+ *************************************************************************/
+int main(int argc, char ** argv)
+{
+   if (argc < 2)
+   {
+      cout << "usage: " << argv[0] << " out.y4m|prefix [frames [workers]]\n";
+      return 1;
+   }
+   string path = argv[1];
+   int frames  = (argc > 2) ? atoi(argv[2]) : 300;
+   int workers = (argc > 3) ? atoi(argv[3]) : 1;
+   bool video = path.size() > 4 && path.compare(path.size() - 4, 4, ".y4m") == 0;
+
+   Position ptUpperRight;
+   ptUpperRight.setZoom(128000.0 /* 128km equals 1 pixel */);
+   ptUpperRight.setPixelsX(WIDTH);
+   ptUpperRight.setPixelsY(HEIGHT);
+   Simulator simulator(ptUpperRight);
+
+   // the run is over once everything queued is written
+   bool good;
+   auto start = chrono::steady_clock::now();
+   {
+      FrameCapture capture(path, video ? CAPTURE_Y4M : CAPTURE_PPM, WIDTH, HEIGHT);
+      CaptureRenderer renderer(capture, CAPTURE_OFFSCREEN, workers);
+      setRenderer(&renderer);
+      for (int i = 0; i < frames; i++)
+      {
+         simulator.update();
+         simulator.draw();
+      }
+      setRenderer(NULL);
+      capture.finish();
+      good = capture.good();
+   }
+   double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+   cout << frames << " frames in " << seconds << " s, "
+        << frames / FRAME_RATE / seconds << " times real time\n";
+   if (!good)
+   {
+      cout << "could not write " << path << endl;
+      return 1;
+   }
+   return 0;
+}
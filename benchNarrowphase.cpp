@@ -0,0 +1,103 @@
+/***********************************************************************
+ * Source File:
+ *    Bench Narrowphase : How fast are the pair tests
+ * Author:
+ *    Emilio Regino, Bradley Payne, Penelope Sanchez
+ * Summary:
+ *    A standalone program timing the lane narrowphase against one
+ *    computeDistance() per pair, in pairs tested per nanosecond. Build
+ *    it on its own, with whatever lanes the machine has:
+ *       g++ -O2 -mavx benchNarrowphase.cpp narrowphase.cpp position.cpp
+ ************************************************************************/
+
+#include "narrowphase.h"   // for TEST PAIRS
+#include "position.h"      // for POSITION, COMPUTE DISTANCE
+#include <chrono>          // for STEADY_CLOCK
+#include <iostream>        // for COUT
+#include <random>          // for MT19937
+#include <vector>          // for VECTOR
+using namespace std;
+
+double Position::metersFromPixels = 40.0;
+
+const size_t NUM_BODIES = 4096;
+const size_t NUM_PAIRS  = 1 << 20;
+const int    NUM_RUNS   = 20;
+
+/*************************************************************************
+ * MEASURE
+ * Best of NUM_RUNS, in pairs per nanosecond, of a pass over every pair
+ *************************************************************************/
+template <class Pass>
+double measure(Pass pass, size_t & numHits)
+{
+   double best = 0.0;
+   for (int run = 0; run < NUM_RUNS; run++)
+   {
+      auto start = chrono::steady_clock::now();
+      numHits = pass();
+      auto stop = chrono::steady_clock::now();
+      double ns = (double)chrono::duration_cast<chrono::nanoseconds>(stop - start).count();
+      if (ns > 0.0 && NUM_PAIRS / ns > best)
+         best = NUM_PAIRS / ns;
+   }
+   return best;
+}
+
+/*************************************************************************
+ * MAIN
+ * Random bodies in a small square so a fair share of pairs touch
+ *************************************************************************/
+int main()
+{
+   mt19937 random(2022);
+   uniform_real_distribution<double> place(0.0, 1000000.0);
+   uniform_real_distribution<double> size(1000.0, 50000.0);
+   uniform_int_distribution<unsigned int> pick(0, NUM_BODIES - 1);
+
+   vector<double> xs(NUM_BODIES);
+   vector<double> ys(NUM_BODIES);
+   vector<double> radii(NUM_BODIES);
+   vector<Position> positions(NUM_BODIES);
+   for (size_t i = 0; i < NUM_BODIES; i++)
+   {
+      xs[i] = place(random);
+      ys[i] = place(random);
+      radii[i] = size(random);
+      positions[i] = Position(xs[i], ys[i]);
+   }
+
+   vector<CandidatePair> pairs(NUM_PAIRS);
+   for (auto & pair : pairs)
+      pair = { pick(random), pick(random) };
+   vector<unsigned char> hits(NUM_PAIRS);
+
+   // the old way: a square root for every pair
+   size_t scalarHits = 0;
+   double scalar = measure([&]()
+   {
+      size_t numHits = 0;
+      for (size_t k = 0; k < NUM_PAIRS; k++)
+      {
+         hits[k] = computeDistance(positions[pairs[k].index1], positions[pairs[k].index2])
+                   < radii[pairs[k].index1] + radii[pairs[k].index2];
+         numHits += hits[k];
+      }
+      return numHits;
+   }, scalarHits);
+
+   // the lanes
+   size_t laneHits = 0;
+   double lanes = measure([&]()
+   {
+      return testPairs(xs.data(), ys.data(), radii.data(),
+                       pairs.data(), NUM_PAIRS, hits.data());
+   }, laneHits);
+
+   cout << "pairs:           " << NUM_PAIRS << "\n";
+   cout << "hits:            " << scalarHits << " scalar, " << laneHits << " lanes\n";
+   cout << "computeDistance: " << scalar << " pairs/ns\n";
+   cout << "testPairs:       " << lanes  << " pairs/ns\n";
+   cout << "speedup:         " << lanes / scalar << "x\n";
+   return 0;
+}
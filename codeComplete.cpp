@@ -21,6 +21,17 @@
 
 #include "test.h"       // for TEST RUNNER
 #include "simulator.h"  // for SIMULATOR
+#include "simulationThread.h" // for SIMULATION THREAD
+#include "renderer.h"   // for NULL RENDERER
+#include "softwareRenderer.h" // for SOFTWARE RENDERER
+#include "parallel.h"   // for NUM WORKERS
+#include "frameCapture.h" // for FRAME CAPTURE
+#include <chrono>       // for STEADY_CLOCK
+#include <cctype>       // for ISDIGIT
+#include <cstdlib>      // for ATOI
+#include <iostream>     // for COUT
+#include <string>       // for STRING
+#include <memory>       // for UNIQUE_PTR
 using namespace std;
 
 /*************************************
@@ -34,12 +45,59 @@ void callBack(const Interface* pUI, void* p)
 {
    // the first step is to cast the void pointer into a game object. This
    // is the first step of every single callback function in OpenGL.
-   Simulator* pDemo = (Simulator*)p;
+   SimulationThread* pPhysics = (SimulationThread*)p;
    
-   pDemo->input(pUI);
-   pDemo->draw();
-   pDemo->update();
+   // the simulation steps on its own thread; we only pass on the keys
+   // and draw whatever it has most recently finished
+   pPhysics->post(Controls(pUI));
+   pPhysics->draw();
+}
+
+/*************************************
+ * RUN HEADLESS
+ * Step the simulator with no window, sending every frame to
+ * a renderer that does not need one, and report how fast
+ * it went.
+ **************************************/
+void runHeadless(Simulator & demo, Renderer & renderer, int frames)
+{
+   setRenderer(&renderer);
+   size_t drawn = 0;
+   size_t culled = 0;
+   auto start = chrono::steady_clock::now();
+   for (int frame = 0; frame < frames; frame++)
+   {
+      demo.draw();
+      drawn += demo.getDrawn();
+      culled += demo.getCulled();
+      demo.update();
+   }
+   chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+   setRenderer(NULL);
+   RenderStats stats = lastFrameStats();
 
+   cout << frames << " frames in " << elapsed.count() << " s ("
+        << frames / elapsed.count() << " frames/s)\n";
+   if (frames > 0)
+      cout << "satellites per frame: " << (double)drawn / frames << " drawn, "
+           << (double)culled / frames << " culled\n";
+   if (RENDER_STATS && frames > 0)
+      cout << "last frame: " << stats.drawCalls << " draw calls, "
+           << stats.vertices << " vertices, " << stats.rotations << " rotations, "
+           << stats.colorChanges << " color changes\n";
+}
+
+/**************************************
+ * FIND OPTION
+ * Where a word is among the arguments after the
+ * backend, or 0 when it is not there
+ **************************************/
+int findOption(int argc, char** argv, const char* option)
+{
+   for (int i = 2; i < argc; i++)
+      if (string(argv[i]) == option)
+         return i;
+   return 0;
 }
 
 double Position::metersFromPixels = 40.0;
@@ -61,20 +119,67 @@ int main(int argc, char** argv)
    // Test
    testRunner();
    
-   // Initialize OpenGL
    Position ptUpperRight;
    ptUpperRight.setZoom(128000.0 /* 128km equals 1 pixel */);
    ptUpperRight.setPixelsX(1000.0);
    ptUpperRight.setPixelsY(1000.0);
+
+   // Without a window: "orbital null [frames]" or "orbital software [frames]".
+   // In a window, "orbital gl stats" shows what each frame costs, and
+   // "orbital gl record out.y4m" (or a prefix for PPM pictures) films it.
+   // Any of them takes "sprites" to draw the parts as sprites.
+   string backend = argc > 1 ? argv[1] : "gl";
+   setPartSprites(findOption(argc, argv, "sprites") != 0);
+   if (backend == "null" || backend == "software")
+   {
+      int frames = 1000;
+      for (int i = 2; i < argc; i++)
+         if (isdigit(argv[i][0]))
+            frames = atoi(argv[i]);
+      Simulator demo(ptUpperRight);
+      if (backend == "null")
+      {
+         NullRenderer renderer;
+         runHeadless(demo, renderer, frames);
+      }
+      else
+      {
+         SoftwareRenderer renderer((int)ptUpperRight.getPixelsX(),
+                                   (int)ptUpperRight.getPixelsY(),
+                                   numWorkers());
+         runHeadless(demo, renderer, frames);
+      }
+      return 0;
+   }
+
+   // Initialize OpenGL
    Interface ui(0, NULL,
       "Orbital",   /* name on the window */
       ptUpperRight);
 
-   // Initialize the demo
+   // Initialize the demo, stepping on its own thread
    Simulator demo(ptUpperRight);
+   demo.setShowStats(findOption(argc, argv, "stats") != 0);
+   SimulationThread physics(demo);
+
+   // the window never hands back control, so the recording lives until
+   // the program exits, and what is still queued is written then
+   static unique_ptr<FrameCapture> pCapture;
+   static unique_ptr<CaptureRenderer> pRecorder;
+   int record = findOption(argc, argv, "record");
+   if (record && record + 1 < argc)
+   {
+      string path = argv[record + 1];
+      bool video = path.size() > 4 && path.compare(path.size() - 4, 4, ".y4m") == 0;
+      pCapture.reset(new FrameCapture(path, video ? CAPTURE_Y4M : CAPTURE_PPM,
+                                      (int)ptUpperRight.getPixelsX(),
+                                      (int)ptUpperRight.getPixelsY()));
+      pRecorder.reset(new CaptureRenderer(*pCapture, CAPTURE_WINDOW));
+      setRenderer(pRecorder.get());
+   }
 
    // set everything into action
-   ui.run(callBack, &demo);
+   ui.run(callBack, &physics);
 
 
    return 0;
@@ -0,0 +1,113 @@
+/***********************************************************************
+ * Header File:
+ *    Collision Event : A record of one collision
+ * Author:
+ *    Emilio Regino, Bradley Payne, Penelope Sanchez
+ * Summary:
+ *    Each collision in a frame becomes a small record in the frame's
+ *    event buffer. Anyone interested (telemetry, the UI, statistics)
+ *    subscribes to the buffer instead of scanning the satellites.
+ ************************************************************************/
+
+#pragma once
+
+#include "collisionScheduler.h"  // for CONTACT
+#include "constants.h"           // for EARTH_ID
+#include <vector>                // for VECTOR
+#include <cmath>                 // for SQRT
+
+/**********************************************************************
+ * COLLISION EVENT
+ * Who hit whom, when, how hard, and where. id2 is EARTH_ID when a
+ * satellite hit the earth.
+ **********************************************************************/
+struct CollisionEvent
+{
+   unsigned int id1;
+   unsigned int id2;
+   double time;            // simulator seconds since the start
+   double dvx;             // velocity of 1 relative to 2, m/s
+   double dvy;
+   double x;               // halfway between the two, in meters
+   double y;
+};
+
+/**********************************************************************
+ * RECORD COLLISION
+ * Make the event record for a contact
+ **********************************************************************/
+inline CollisionEvent recordCollision(const Contact & contact, double time)
+{
+   const Satellite & satellite1 = *contact.pSatellite1;
+   Position position1 = satellite1.getPosition();
+   Velocity velocity1 = satellite1.getVelocity();
+
+   CollisionEvent event;
+   event.id1 = satellite1.getId();
+   event.time = time;
+   if (contact.pSatellite2)
+   {
+      Position position2 = contact.pSatellite2->getPosition();
+      Velocity velocity2 = contact.pSatellite2->getVelocity();
+      event.id2 = contact.pSatellite2->getId();
+      event.dvx = velocity1.getX() - velocity2.getX();
+      event.dvy = velocity1.getY() - velocity2.getY();
+      event.x = (position1.getMetersX() + position2.getMetersX()) / 2.0;
+      event.y = (position1.getMetersY() + position2.getMetersY()) / 2.0;
+   }
+   else
+   {
+      event.id2 = EARTH_ID;
+      event.dvx = velocity1.getX();
+      event.dvy = velocity1.getY();
+      event.x = position1.getMetersX();
+      event.y = position1.getMetersY();
+   }
+   return event;
+}
+
+/**********************************************************************
+ * COLLISION LISTENER
+ * Anything that wants to hear about collisions. Called once a frame
+ * with all of that frame's events, after the breakup.
+ **********************************************************************/
+class CollisionListener
+{
+public:
+   virtual ~CollisionListener() {}
+   virtual void notify(const std::vector<CollisionEvent> & events) = 0;
+};
+
+/**********************************************************************
+ * COLLISION TALLY
+ * A running count of what has collided since the start
+ **********************************************************************/
+class CollisionTally : public CollisionListener
+{
+public:
+   CollisionTally() : collisions(0), impacts(0), fastest(0.0) {}
+
+   void notify(const std::vector<CollisionEvent> & events)
+   {
+      for (auto & event : events)
+      {
+         if (event.id2 == EARTH_ID)
+            impacts++;
+         else
+            collisions++;
+
+         double speed2 = event.dvx * event.dvx + event.dvy * event.dvy;
+         if (speed2 > fastest * fastest)
+            fastest = sqrt(speed2);
+      }
+   }
+
+   unsigned long getCollisions() const { return collisions; }
+   unsigned long getImpacts()    const { return impacts;    }
+   double getFastest()           const { return fastest;    }
+
+private:
+   unsigned long collisions;     // satellite against satellite
+   unsigned long impacts;        // satellite against the earth
+   double fastest;               // highest relative speed seen, m/s
+};
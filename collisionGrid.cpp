@@ -0,0 +1,243 @@
+/***********************************************************************
+ * Source File:
+ *    Collision Grid : Parallel grid-based collision detection
+ * Author:
+ *    Emilio Regino, Bradley Payne, Penelope Sanchez
+ * Summary:
+ *    Snapshot, bin, generate pairs per worker, merge, narrowphase, and
+ *    finally a serial pass that sorts the results so they come out the
+ *    same no matter how the threads were scheduled.
+ ************************************************************************/
+
+#include "collisionGrid.h"   // for COLLISION GRID
+#include "parallel.h"        // for PARALLEL FOR
+#include "constants.h"       // for EARTH_RADIUS, EARTH_ID
+#include <algorithm>         // for SORT, LOWER_BOUND
+#include <utility>           // for PAIR
+#include <cmath>             // for FLOOR
+#include <cassert>           // for ASSERT
+
+// fewest cells, pairs, or bodies worth handing to another thread
+const size_t GRAIN = 256;
+
+/**********************************************************************
+ * CONSTRUCTOR
+ **********************************************************************/
+CollisionGrid :: CollisionGrid(int workers) :
+   workers(workers < 1 ? 1 : workers), cellSize(1.0), capacity(0)
+{
+   buffers.resize(this->workers);
+}
+
+/**********************************************************************
+ * DETECT
+ * Find every pair of live satellites that touch and every satellite
+ * inside the earth. They are killed, and reported sorted by id with
+ * the lower id first.
+ **********************************************************************/
+void CollisionGrid :: detect(const std::list<Satellite *> & satellites,
+                             std::vector<Contact> & contacts)
+{
+   snapshot(satellites);
+   bin();
+   generatePairs();
+   narrowphase();
+
+   // gather the results in an order that does not depend on the threads
+   size_t first = contacts.size();
+   for (size_t i = 0; i < pairs.size(); i++)
+      if (hits[i])
+      {
+         Satellite * pSatellite1 = bodies[pairs[i].index1];
+         Satellite * pSatellite2 = bodies[pairs[i].index2];
+         if (pSatellite2->getId() < pSatellite1->getId())
+            std::swap(pSatellite1, pSatellite2);
+         contacts.push_back({ pSatellite1, pSatellite2 });
+      }
+   for (size_t i = 0; i < bodies.size(); i++)
+      if (grounded[i])
+         contacts.push_back({ bodies[i], NULL });
+
+   std::sort(contacts.begin() + first, contacts.end(),
+             [](const Contact & lhs, const Contact & rhs)
+             {
+                unsigned int lhs1 = lhs.pSatellite1->getId();
+                unsigned int rhs1 = rhs.pSatellite1->getId();
+                unsigned int lhs2 = lhs.pSatellite2 ? lhs.pSatellite2->getId() : EARTH_ID;
+                unsigned int rhs2 = rhs.pSatellite2 ? rhs.pSatellite2->getId() : EARTH_ID;
+                return (lhs1 != rhs1) ? lhs1 < rhs1 : lhs2 < rhs2;
+             });
+
+   for (size_t i = 0; i < bodies.size(); i++)
+      if (killed[i].load(std::memory_order_relaxed))
+         bodies[i]->kill();
+}
+
+/**********************************************************************
+ * SNAPSHOT
+ * Copy out where every live satellite is, so the workers read flat
+ * arrays instead of chasing list nodes
+ **********************************************************************/
+void CollisionGrid :: snapshot(const std::list<Satellite *> & satellites)
+{
+   bodies.clear();
+   xs.clear();
+   ys.clear();
+   radii.clear();
+   for (auto satellite : satellites)
+      if (!satellite->isDead() && !satellite->hasExpired())
+      {
+         Position position = satellite->getPosition();
+         bodies.push_back(satellite);
+         xs.push_back(position.getMetersX());
+         ys.push_back(position.getMetersY());
+         radii.push_back(satellite->getRadius());
+      }
+
+   // kill flags are atomics, which cannot live in a growing vector
+   if (bodies.size() > capacity)
+   {
+      capacity = bodies.size() * 2;
+      killed.reset(new std::atomic<unsigned char>[capacity]);
+   }
+   for (size_t i = 0; i < bodies.size(); i++)
+      killed[i].store(0, std::memory_order_relaxed);
+   grounded.assign(bodies.size(), 0);
+}
+
+/**********************************************************************
+ * BIN
+ * Sort the bodies into cells at least as wide as the widest pair of
+ * satellites, so anything touching is in the same or a neighboring cell
+ **********************************************************************/
+void CollisionGrid :: bin()
+{
+   double widest = 0.0;
+   for (double radius : radii)
+      widest = std::max(widest, radius);
+   cellSize = std::max(2.0 * widest, 1.0);
+
+   std::vector<std::pair<uint64_t, unsigned int> > entries(bodies.size());
+   for (size_t i = 0; i < bodies.size(); i++)
+      entries[i] = std::make_pair(cellKey((int64_t)floor(xs[i] / cellSize),
+                                          (int64_t)floor(ys[i] / cellSize)),
+                                  (unsigned int)i);
+   std::sort(entries.begin(), entries.end());
+
+   cellKeys.clear();
+   cellStarts.clear();
+   cellBodies.resize(entries.size());
+   for (size_t i = 0; i < entries.size(); i++)
+   {
+      if (i == 0 || entries[i].first != entries[i - 1].first)
+      {
+         cellKeys.push_back(entries[i].first);
+         cellStarts.push_back((unsigned int)i);
+      }
+      cellBodies[i] = entries[i].second;
+   }
+   cellStarts.push_back((unsigned int)entries.size());
+}
+
+/**********************************************************************
+ * FIND CELL
+ * Which occupied cell has a given key, or cellKeys.size() if none does
+ **********************************************************************/
+size_t CollisionGrid :: findCell(uint64_t key) const
+{
+   auto it = std::lower_bound(cellKeys.begin(), cellKeys.end(), key);
+   if (it == cellKeys.end() || *it != key)
+      return cellKeys.size();
+   return it - cellKeys.begin();
+}
+
+/**********************************************************************
+ * GENERATE PAIRS
+ * Each worker takes a slice of the cells and pairs every body in a cell
+ * with the rest of its cell and with four of its eight neighbors (the
+ * other four pair with it from their side). The per-worker buffers are
+ * then copied into one list, each worker writing its own stretch.
+ **********************************************************************/
+void CollisionGrid :: generatePairs()
+{
+   for (auto & buffer : buffers)
+      buffer.clear();
+
+   parallelFor(cellKeys.size(), workers, GRAIN,
+               [this](int worker, size_t begin, size_t end)
+   {
+      std::vector<CandidatePair> & buffer = buffers[worker];
+      const int64_t neighbors[4][2] = { { 1, 0 }, { 1, 1 }, { 0, 1 }, { -1, 1 } };
+
+      for (size_t cell = begin; cell < end; cell++)
+      {
+         int64_t cx = (int32_t)(cellKeys[cell] >> 32);
+         int64_t cy = (int32_t)(cellKeys[cell] & 0xffffffff);
+
+         // everything in this cell against everything later in it
+         for (unsigned int i = cellStarts[cell]; i < cellStarts[cell + 1]; i++)
+            for (unsigned int j = i + 1; j < cellStarts[cell + 1]; j++)
+               buffer.push_back({ cellBodies[i], cellBodies[j] });
+
+         // everything in this cell against the forward neighbors
+         for (int n = 0; n < 4; n++)
+         {
+            size_t other = findCell(cellKey(cx + neighbors[n][0], cy + neighbors[n][1]));
+            if (other == cellKeys.size())
+               continue;
+            for (unsigned int i = cellStarts[cell]; i < cellStarts[cell + 1]; i++)
+               for (unsigned int j = cellStarts[other]; j < cellStarts[other + 1]; j++)
+                  buffer.push_back({ cellBodies[i], cellBodies[j] });
+         }
+      }
+   });
+
+   // where each buffer lands in the merged list
+   std::vector<size_t> offsets(buffers.size() + 1, 0);
+   for (size_t w = 0; w < buffers.size(); w++)
+      offsets[w + 1] = offsets[w] + buffers[w].size();
+
+   pairs.resize(offsets.back());
+   parallelFor(buffers.size(), workers, 1,
+               [this, &offsets](int, size_t begin, size_t end)
+   {
+      for (size_t w = begin; w < end; w++)
+         std::copy(buffers[w].begin(), buffers[w].end(), pairs.begin() + offsets[w]);
+   });
+}
+
+/**********************************************************************
+ * NARROWPHASE
+ * The exact test on every candidate pair, several at a time, and every
+ * body against the earth. Squared distances, so no square roots.
+ **********************************************************************/
+void CollisionGrid :: narrowphase()
+{
+   hits.assign(pairs.size(), 0);
+
+   parallelFor(pairs.size(), workers, GRAIN,
+               [this](int, size_t begin, size_t end)
+   {
+      if (!testPairs(xs.data(), ys.data(), radii.data(),
+                     pairs.data() + begin, end - begin, hits.data() + begin))
+         return;
+
+      for (size_t k = begin; k < end; k++)
+         if (hits[k])
+         {
+            killed[pairs[k].index1].store(1, std::memory_order_relaxed);
+            killed[pairs[k].index2].store(1, std::memory_order_relaxed);
+         }
+   });
+
+   parallelFor(bodies.size(), workers, GRAIN,
+               [this](int, size_t begin, size_t end)
+   {
+      for (size_t i = begin; i < end; i++)
+         if (xs[i] * xs[i] + ys[i] * ys[i] < EARTH_RADIUS * EARTH_RADIUS)
+         {
+            grounded[i] = 1;
+            killed[i].store(1, std::memory_order_relaxed);
+         }
+   });
+}
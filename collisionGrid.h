@@ -0,0 +1,80 @@
+/***********************************************************************
+ * Header File:
+ *    Collision Grid : Parallel grid-based collision detection
+ * Author:
+ *    Emilio Regino, Bradley Payne, Penelope Sanchez
+ * Summary:
+ *    For crowded skies, where certificates are too short to pay off.
+ *    Satellites are binned into a uniform grid of cells at least as wide
+ *    as the largest satellite, so anything touching shares a cell or sits
+ *    in a neighboring one. Workers each scan a slice of the cells into
+ *    their own pair buffer, the buffers are merged without locks, and the
+ *    narrowphase runs in parallel over the merged list.
+ ************************************************************************/
+
+#pragma once
+
+#include "satellite.h"           // for SATELLITE
+#include "collisionScheduler.h"  // for CONTACT
+#include "narrowphase.h"         // for CANDIDATE PAIR
+#include <list>                  // for LIST
+#include <vector>                // for VECTOR
+#include <atomic>                // for ATOMIC
+#include <memory>                // for UNIQUE_PTR
+#include <cstdint>               // for UINT64_T
+
+class TestCollisionGrid;
+
+/**********************************************************************
+ * COLLISION GRID
+ * Finds every touching pair, and everything inside the earth, in one
+ * sweep. The results do not depend on the number of workers.
+ **********************************************************************/
+class CollisionGrid
+{
+public:
+   friend TestCollisionGrid;
+
+   CollisionGrid(int workers);
+
+   // kill everything touching and report it, sorted by id
+   void detect(const std::list<Satellite *> & satellites, std::vector<Contact> & contacts);
+
+   size_t getCandidates() const { return pairs.size(); }
+
+private:
+   void snapshot(const std::list<Satellite *> & satellites);
+   void bin();
+   void generatePairs();
+   void narrowphase();
+
+   size_t findCell(uint64_t key) const;
+   static uint64_t cellKey(int64_t cx, int64_t cy)
+   {
+      return ((uint64_t)(uint32_t)cx << 32) | (uint32_t)cy;
+   }
+
+   int workers;                                 // most threads to use
+
+   // this frame's snapshot of the live satellites
+   std::vector<Satellite *> bodies;
+   std::vector<double> xs;
+   std::vector<double> ys;
+   std::vector<double> radii;
+
+   // the grid: cells sorted by key, each a run of bodies
+   double cellSize;
+   std::vector<uint64_t> cellKeys;              // key of each occupied cell
+   std::vector<unsigned int> cellStarts;        // first of each run in cellBodies
+   std::vector<unsigned int> cellBodies;        // body indices, grouped by cell
+
+   // pairs, one buffer per worker then merged
+   std::vector<std::vector<CandidatePair> > buffers;
+   std::vector<CandidatePair> pairs;
+   std::vector<unsigned char> hits;             // one per pair
+   std::vector<unsigned char> grounded;         // one per body, inside the earth
+
+   // any worker may set any body's flag, so they have to be atomic
+   std::unique_ptr<std::atomic<unsigned char>[]> killed;
+   size_t capacity;
+};
@@ -0,0 +1,200 @@
+/***********************************************************************
+ * Source File:
+ *    Collision Scheduler : Event-driven collision detection
+ * Author:
+ *    Emilio Regino, Bradley Payne, Penelope Sanchez
+ * Summary:
+ *    Keeps a certificate for every pair of satellites and for every
+ *    satellite against the earth, and only re-tests a pair once its
+ *    certificate has run out.
+ ************************************************************************/
+
+#include "collisionScheduler.h"   // for COLLISION SCHEDULER
+#include <cmath>                  // for SQRT and NEXTAFTER
+#include <cassert>                // for ASSERT
+#include <utility>                // for MOVE
+
+/**********************************************************************
+ * INSERT
+ * Start watching a satellite. It gets a certificate against everything
+ * already being watched and one against the earth.
+ **********************************************************************/
+void CollisionScheduler :: insert(Satellite * pSatellite, double time)
+{
+   assert(pSatellite != NULL);
+   assert(!isTracked(pSatellite));
+
+   for (auto & other : population)
+      schedule(*pSatellite, *other.second, time);
+   scheduleEarth(*pSatellite, time);
+
+   population[pSatellite->getId()] = pSatellite;
+}
+
+/**********************************************************************
+ * REMOVE
+ * Stop watching a satellite. Its certificates are not dug out of the
+ * queue; they are simply ignored when they come due.
+ **********************************************************************/
+void CollisionScheduler :: remove(const Satellite * pSatellite)
+{
+   population.erase(pSatellite->getId());
+}
+
+/**********************************************************************
+ * RESET
+ * Forget everything
+ **********************************************************************/
+void CollisionScheduler :: reset()
+{
+   population.clear();
+   events = std::priority_queue<Event, std::vector<Event>, std::greater<Event> >();
+   now = 0.0;
+}
+
+/**********************************************************************
+ * ADVANCE
+ * Move the clock to a new time and re-test every pair whose
+ * certificate ran out on the way. Pairs that touch are reported and
+ * both satellites stop being watched; the rest get a new certificate.
+ **********************************************************************/
+void CollisionScheduler :: advance(double time, std::vector<Contact> & contacts)
+{
+   assert(time >= now);
+   now = time;
+
+   while (!events.empty() && events.top().time <= now)
+   {
+      Event event = events.top();
+      events.pop();
+
+      // stale: one of the two has since been removed
+      auto it1 = population.find(event.id1);
+      if (it1 == population.end())
+         continue;
+      Satellite * pSatellite1 = it1->second;
+
+      // the satellite against the earth
+      if (event.id2 == EARTH_ID)
+      {
+         if (pSatellite1->isDead() || pSatellite1->hasExpired())
+            continue;
+
+         if (computeDistance(pSatellite1->getPosition(), Position()) < EARTH_RADIUS)
+         {
+            contacts.push_back({ pSatellite1, NULL });
+            population.erase(it1);
+         }
+         else
+            scheduleEarth(*pSatellite1, now);
+         continue;
+      }
+
+      // the satellite against another satellite
+      auto it2 = population.find(event.id2);
+      if (it2 == population.end())
+         continue;
+      Satellite * pSatellite2 = it2->second;
+
+      if (pSatellite1->isDead()      || pSatellite2->isDead() ||
+          pSatellite1->hasExpired()  || pSatellite2->hasExpired())
+         continue;
+
+      double distance = computeDistance(pSatellite1->getPosition(), pSatellite2->getPosition());
+      if (distance < pSatellite1->getRadius() + pSatellite2->getRadius())
+      {
+         contacts.push_back({ pSatellite1, pSatellite2 });
+         population.erase(it1);
+         population.erase(event.id2);
+      }
+      else
+         schedule(*pSatellite1, *pSatellite2, now);
+   }
+
+   compact();
+}
+
+/**********************************************************************
+ * SCHEDULE
+ * Compute the certificate for a pair of satellites: the soonest they
+ * could touch if they headed straight at each other with everything
+ * the simulator can throw at them.
+ **********************************************************************/
+void CollisionScheduler :: schedule(const Satellite & satellite1,
+                                    const Satellite & satellite2, double time)
+{
+   double gap = computeDistance(satellite1.getPosition(), satellite2.getPosition()) -
+                (satellite1.getRadius() + satellite2.getRadius());
+
+   double dx = satellite1.getVelocity().getX() - satellite2.getVelocity().getX();
+   double dy = satellite1.getVelocity().getY() - satellite2.getVelocity().getY();
+   double speed = sqrt(dx * dx + dy * dy);
+
+   double when = time + timeToClose(gap, speed, 2.0 * MAX_ACCELERATION);
+
+   // a pair that is apart must be looked at strictly later, or we spin
+   if (gap > 0.0 && when <= time)
+      when = std::nextafter(time, INFINITY);
+
+   unsigned int id1 = satellite1.getId();
+   unsigned int id2 = satellite2.getId();
+   events.push({ when, id1 < id2 ? id1 : id2, id1 < id2 ? id2 : id1 });
+}
+
+/**********************************************************************
+ * SCHEDULE EARTH
+ * Compute the certificate for a satellite against the earth
+ **********************************************************************/
+void CollisionScheduler :: scheduleEarth(const Satellite & satellite, double time)
+{
+   double gap = computeDistance(satellite.getPosition(), Position()) - EARTH_RADIUS;
+   double speed = satellite.getVelocity().getSpeed();
+
+   double when = time + timeToClose(gap, speed, MAX_ACCELERATION);
+   if (gap > 0.0 && when <= time)
+      when = std::nextafter(time, INFINITY);
+
+   events.push({ when, satellite.getId(), EARTH_ID });
+}
+
+/**********************************************************************
+ * COMPACT
+ * Stale certificates pile up as satellites die. When they outnumber the
+ * live ones, rebuild the queue without them.
+ **********************************************************************/
+void CollisionScheduler :: compact()
+{
+   size_t live = population.size() * (population.size() + 1) / 2;
+   if (events.size() <= 2 * live + 64)
+      return;
+
+   std::vector<Event> keep;
+   keep.reserve(live);
+   while (!events.empty())
+   {
+      const Event & event = events.top();
+      if (population.count(event.id1) &&
+          (event.id2 == EARTH_ID || population.count(event.id2)))
+         keep.push_back(event);
+      events.pop();
+   }
+   events = std::priority_queue<Event, std::vector<Event>, std::greater<Event> >(
+               std::greater<Event>(), std::move(keep));
+}
+
+/**********************************************************************
+ * TIME TO CLOSE
+ * How long it takes to eat up a gap starting at a given closing speed
+ * and accelerating as hard as possible. Each frame moves a satellite
+ * by v t + 1.5 a t^2 (velocity is updated before position), so that is
+ * the bound we solve:
+ *
+ *    1.5 a t^2 + s t = gap
+ *    t = 2 gap / (s + sqrt(s^2 + 6 a gap))
+ **********************************************************************/
+double CollisionScheduler :: timeToClose(double gap, double speed, double acceleration)
+{
+   if (gap <= 0.0)
+      return 0.0;
+   return (2.0 * gap) / (speed + sqrt(speed * speed + 6.0 * acceleration * gap));
+}
@@ -0,0 +1,93 @@
+/***********************************************************************
+ * Header File:
+ *    Collision Scheduler : Event-driven collision detection
+ * Author:
+ *    Emilio Regino, Bradley Payne, Penelope Sanchez
+ * Summary:
+ *    Rather than testing every pair of satellites every frame, each
+ *    pair (and each satellite against the earth) carries a certificate:
+ *    the earliest time the two could possibly touch given how far apart
+ *    they are, how fast they close, and how hard anything in the
+ *    simulator can accelerate. Certificates live in a priority queue and
+ *    a pair is only looked at again when its certificate runs out.
+ ************************************************************************/
+
+#pragma once
+
+#include "satellite.h"     // for SATELLITE
+#include "constants.h"     // for EARTH_ID, MAX_ACCELERATION
+#include <queue>           // for PRIORITY_QUEUE
+#include <vector>          // for VECTOR
+#include <functional>      // for GREATER
+#include <unordered_map>   // for UNORDERED_MAP
+
+class TestCollisionScheduler;
+
+/**********************************************************************
+ * CONTACT
+ * Two bodies found touching. pSatellite2 is NULL when the satellite
+ * hit the earth.
+ **********************************************************************/
+struct Contact
+{
+   Satellite * pSatellite1;
+   Satellite * pSatellite2;
+};
+
+/**********************************************************************
+ * COLLISION SCHEDULER
+ * A kinetic collision engine. Work per frame is proportional to the
+ * number of certificates that expire, not to the number of pairs.
+ **********************************************************************/
+class CollisionScheduler
+{
+public:
+   friend TestCollisionScheduler;
+
+   CollisionScheduler() : now(0.0) {}
+
+   // population
+   void insert(Satellite * pSatellite, double time);
+   void remove(const Satellite * pSatellite);
+   bool isTracked(const Satellite * pSatellite) const
+   {
+      return population.find(pSatellite->getId()) != population.end();
+   }
+   void reset();
+
+   // move the clock forward and report everything that touched
+   void advance(double time, std::vector<Contact> & contacts);
+
+   // how many certificates are waiting, stale ones included
+   size_t getPending() const { return events.size(); }
+
+private:
+   /******************************************************
+    * EVENT
+    * The time a pair's certificate runs out. id2 is
+    * EARTH_ID for a satellite against the earth.
+    ******************************************************/
+   struct Event
+   {
+      double time;
+      unsigned int id1;
+      unsigned int id2;
+      bool operator > (const Event & rhs) const
+      {
+         // ties broken on the ids so the order never depends on the hash
+         if (time != rhs.time) return time > rhs.time;
+         if (id1  != rhs.id1)  return id1  > rhs.id1;
+         return id2 > rhs.id2;
+      }
+   };
+
+   void schedule(const Satellite & satellite1, const Satellite & satellite2, double time);
+   void scheduleEarth(const Satellite & satellite, double time);
+   void compact();
+
+   static double timeToClose(double gap, double speed, double acceleration);
+
+   std::priority_queue<Event, std::vector<Event>, std::greater<Event> > events;
+   std::unordered_map<unsigned int, Satellite *> population;
+   double now;                      // simulator time of the last advance
+};
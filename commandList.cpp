@@ -0,0 +1,373 @@
+/***********************************************************************
+ * Source File:
+ *    Command List : A frame's drawing, written down
+ * Author:
+ *    Emilio Regino, Bradley Payne, Penelope Sanchez
+ * Summary:
+ *    Writing commands and playing them back. Positions are kept in pixels
+ *    as floats, the precision the vertices end up with anyway. Anything
+ *    random, such as the flicker of the ship's flame, is decided when the
+ *    command is recorded so every playback looks the same.
+ ************************************************************************/
+
+#include "commandList.h"   // for COMMAND LIST
+#include "uiDraw.h"        // for the draw* functions
+#include <algorithm>       // for MIN
+#include <cassert>         // for ASSERT
+#include <cstdint>         // for UINT16_T and UINT32_T
+
+typedef void (*DrawPart)(const Position &, double);
+typedef void (*DrawPartAt)(const Position &, double, const Position &);
+
+// the parts that take a center and rotation, by opcode
+static const DrawPart DRAW_PART[] =
+{
+   NULL,
+   drawFragment,
+   drawCrewDragonCenter,
+   drawSputnik,
+   drawGPSCenter,
+   drawEarth
+};
+
+// the parts that also sit at an offset, from OP_CREW_DRAGON_RIGHT on
+static const DrawPartAt DRAW_PART_AT[] =
+{
+   drawCrewDragonRight,
+   drawCrewDragonLeft,
+   drawGPSRight,
+   drawGPSLeft,
+   drawHubbleTelescope,
+   drawHubbleComputer,
+   drawHubbleLeft,
+   drawHubbleRight,
+   drawStarlinkBody,
+   drawStarlinkArray
+};
+
+/*************************************************************************
+ * PART
+ * A part drawn around its own center
+ *************************************************************************/
+void CommandList :: part(Opcode opcode, const Position & center, double rotation)
+{
+   assert(OP_FRAGMENT <= opcode && opcode <= OP_EARTH);
+   unsigned char * p = grow(1 + 3 * sizeof(float));
+   p = put(p, opcode);
+   p = putPixels(p, center);
+   put(p, (float)rotation);
+}
+
+/*************************************************************************
+ * PART
+ * A piece of a satellite, sitting at an offset from its center
+ *************************************************************************/
+void CommandList :: part(Opcode opcode, const Position & center, double rotation,
+                         const Position & offset)
+{
+   assert(OP_CREW_DRAGON_RIGHT <= opcode && opcode <= OP_STARLINK_ARRAY);
+   unsigned char * p = grow(1 + 5 * sizeof(float));
+   p = put(p, opcode);
+   p = putPixels(p, center);
+   p = put(p, (float)rotation);
+   putPixels(p, offset);
+}
+
+/*************************************************************************
+ * PROJECTILE
+ *************************************************************************/
+void CommandList :: projectile(const Position & center)
+{
+   unsigned char * p = grow(1 + 2 * sizeof(float));
+   p = put(p, OP_PROJECTILE);
+   putPixels(p, center);
+}
+
+/*************************************************************************
+ * SHIP
+ * The ship, with the two tips of its flame when the thrusters are on
+ *************************************************************************/
+void CommandList :: ship(const Position & center, double rotation, const double * flame)
+{
+   unsigned char * p = grow(1 + (flame ? 7 : 3) * sizeof(float));
+   p = put(p, flame ? OP_SHIP_THRUST : OP_SHIP);
+   p = putPixels(p, center);
+   p = put(p, (float)rotation);
+   if (flame)
+      for (int i = 0; i < 4; i++)
+         p = put(p, (float)flame[i]);
+}
+
+/*************************************************************************
+ * STARS
+ * A whole field of stars in one command: every position, then every
+ * phase, so each can be played back as one block
+ *************************************************************************/
+void CommandList :: stars(const Position * points, const unsigned char * phases, size_t num)
+{
+   unsigned char * p = grow(1 + sizeof(uint32_t) + num * (2 * sizeof(float) + 1));
+   p = put(p, OP_STARS);
+   p = put(p, (uint32_t)num);
+   for (size_t i = 0; i < num; i++)
+      p = putPixels(p, points[i]);
+   memcpy(p, phases, num);
+}
+
+/*************************************************************************
+ * TRAIL
+ * Where something has been, oldest first, in one command
+ *************************************************************************/
+void CommandList :: trail(const Position * points, size_t num)
+{
+   unsigned char * p = grow(1 + sizeof(uint32_t) + num * 2 * sizeof(float));
+   p = put(p, OP_TRAIL);
+   p = put(p, (uint32_t)num);
+   for (size_t i = 0; i < num; i++)
+      p = putPixels(p, points[i]);
+}
+
+/*************************************************************************
+ * HEAT MAP
+ * A level for every pixel, cut off at 65535 on a side
+ *************************************************************************/
+void CommandList :: heatMap(const unsigned char * levels, int width, int height)
+{
+   assert(0 <= width && width <= UINT16_MAX && 0 <= height && height <= UINT16_MAX);
+   size_t num = (size_t)width * height;
+   unsigned char * p = grow(1 + 2 * sizeof(uint16_t) + num);
+   p = put(p, OP_HEAT_MAP);
+   p = put(p, (uint16_t)width);
+   p = put(p, (uint16_t)height);
+   memcpy(p, levels, num);
+}
+
+/*************************************************************************
+ * TEXT
+ * One line of text, cut off at 65535 characters
+ *************************************************************************/
+void CommandList :: text(const Position & topLeft, const char * text, size_t length)
+{
+   length = std::min(length, (size_t)UINT16_MAX);
+   unsigned char * p = grow(1 + 2 * sizeof(float) + sizeof(uint16_t) + length);
+   p = put(p, OP_TEXT);
+   p = putPixels(p, topLeft);
+   p = put(p, (uint16_t)length);
+   memcpy(p, text, length);
+}
+
+/*************************************************************************
+ * DETAIL
+ * How much of the parts that follow to draw
+ *************************************************************************/
+void CommandList :: detail(unsigned char detail)
+{
+   unsigned char * p = grow(2);
+   p = put(p, OP_DETAIL);
+   put(p, detail);
+}
+
+/*************************************************************************
+ * APPEND
+ *************************************************************************/
+void CommandList :: append(const CommandList & rhs)
+{
+   bytes.insert(bytes.end(), rhs.bytes.begin(), rhs.bytes.end());
+   commands += rhs.commands;
+}
+
+/*************************************************************************
+ * GET PIXELS
+ * Read back a position written by putPixels()
+ *************************************************************************/
+Position CommandList :: getPixels(size_t & at) const
+{
+   Position pt;
+   pt.setPixelsX(get<float>(at));
+   pt.setPixelsY(get<float>(at));
+   return pt;
+}
+
+/*************************************************************************
+ * REPLAY
+ * Draw every command, in order, into the frame. While playing back,
+ * the draw* functions draw instead of recording.
+ *************************************************************************/
+void CommandList :: replay() const
+{
+   CommandList * pSaved = recordInto(NULL);
+
+   // reused from one playback to the next
+   static std::vector<float> points;
+
+   size_t at = 0;
+   while (at < bytes.size())
+   {
+      Opcode opcode = get<Opcode>(at);
+
+      // the detail, the stars, the trails, and the heat map are the
+      // commands without a position
+      if (opcode == OP_DETAIL)
+      {
+         drawDetail((Detail)get<unsigned char>(at));
+         continue;
+      }
+      if (opcode == OP_STARS)
+      {
+         size_t num = get<uint32_t>(at);
+         points.resize(num * 2);
+         memcpy(points.data(), bytes.data() + at, num * 2 * sizeof(float));
+         at += num * 2 * sizeof(float);
+         drawStars(points.data(), bytes.data() + at, num);
+         at += num;
+         continue;
+      }
+      if (opcode == OP_TRAIL)
+      {
+         size_t num = get<uint32_t>(at);
+         points.resize(num * 2);
+         memcpy(points.data(), bytes.data() + at, num * 2 * sizeof(float));
+         at += num * 2 * sizeof(float);
+         drawTrail(points.data(), num);
+         continue;
+      }
+      if (opcode == OP_HEAT_MAP)
+      {
+         int width = get<uint16_t>(at);
+         int height = get<uint16_t>(at);
+         drawHeatMap(bytes.data() + at, width, height);
+         at += (size_t)width * height;
+         continue;
+      }
+
+      Position center = getPixels(at);
+      switch (opcode)
+      {
+         case OP_PROJECTILE:
+            drawProjectile(center);
+            break;
+
+         case OP_SHIP:
+         case OP_SHIP_THRUST:
+         {
+            double rotation = get<float>(at);
+            double flame[4];
+            if (opcode == OP_SHIP_THRUST)
+               for (int i = 0; i < 4; i++)
+                  flame[i] = get<float>(at);
+            drawShip(center, rotation, opcode == OP_SHIP_THRUST ? flame : NULL);
+            break;
+         }
+
+         case OP_TEXT:
+         {
+            size_t length = get<uint16_t>(at);
+            drawText(center, (const char *)bytes.data() + at, length);
+            at += length;
+            break;
+         }
+
+         default:
+         {
+            double rotation = get<float>(at);
+            if (opcode < OP_CREW_DRAGON_RIGHT)
+               DRAW_PART[opcode](center, rotation);
+            else
+               DRAW_PART_AT[opcode - OP_CREW_DRAGON_RIGHT](center, rotation, getPixels(at));
+         }
+      }
+   }
+   assert(at == bytes.size());
+
+   recordInto(pSaved);
+}
+
+/*************************************************************************
+ * SKIP
+ * Where the command after the one starting at a given byte begins
+ *************************************************************************/
+size_t CommandList :: skip(size_t at) const
+{
+   Opcode opcode = get<Opcode>(at);
+   switch (opcode)
+   {
+      case OP_PROJECTILE:
+         return at + 2 * sizeof(float);
+      case OP_DETAIL:
+         return at + 1;
+      case OP_SHIP:
+         return at + 3 * sizeof(float);
+      case OP_SHIP_THRUST:
+         return at + 7 * sizeof(float);
+      case OP_STARS:
+      {
+         size_t num = get<uint32_t>(at);
+         return at + (2 * sizeof(float) + 1) * num;
+      }
+      case OP_TRAIL:
+      {
+         size_t num = get<uint32_t>(at);
+         return at + 2 * sizeof(float) * num;
+      }
+      case OP_HEAT_MAP:
+      {
+         size_t width = get<uint16_t>(at);
+         size_t height = get<uint16_t>(at);
+         return at + width * height;
+      }
+      case OP_TEXT:
+      {
+         at += 2 * sizeof(float);
+         size_t length = get<uint16_t>(at);
+         return at + length;
+      }
+      default:
+         return at + (opcode < OP_CREW_DRAGON_RIGHT ? 3 : 5) * sizeof(float);
+   }
+}
+
+/*************************************************************************
+ * COMPARE
+ * Walk two lists side by side to find where they part ways, for
+ * catching a change in what a build draws
+ *************************************************************************/
+size_t CommandList :: compare(const CommandList & rhs) const
+{
+   size_t index = 0;
+   size_t at = 0;
+   while (at < bytes.size() && at < rhs.bytes.size())
+   {
+      size_t next = skip(at);
+      if (next != rhs.skip(at) ||
+          memcmp(&bytes[at], &rhs.bytes[at], next - at) != 0)
+         return index;
+      at = next;
+      index++;
+   }
+   return (commands == rhs.commands) ? commands : index;
+}
+
+/*************************************************************************
+ * SAVE
+ * Write the list out: the number of commands, then the bytes
+ *************************************************************************/
+bool CommandList :: save(std::ostream & out) const
+{
+   uint32_t header[2] = { (uint32_t)commands, (uint32_t)bytes.size() };
+   out.write((const char *)header, sizeof(header));
+   out.write((const char *)bytes.data(), bytes.size());
+   return out.good();
+}
+
+/*************************************************************************
+ * LOAD
+ * Read a list written by save()
+ *************************************************************************/
+bool CommandList :: load(std::istream & in)
+{
+   uint32_t header[2];
+   if (!in.read((char *)header, sizeof(header)))
+      return false;
+   commands = header[0];
+   bytes.resize(header[1]);
+   return (bool)in.read((char *)bytes.data(), bytes.size());
+}
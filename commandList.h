@@ -0,0 +1,134 @@
+/***********************************************************************
+ * Header File:
+ *    Command List : A frame's drawing, written down
+ * Author:
+ *    Emilio Regino, Bradley Payne, Penelope Sanchez
+ * Summary:
+ *    The draw* functions do not draw right away. Each call is written
+ *    into a command list as a one-byte opcode followed by its parameters,
+ *    in pixels, packed end to end. The list is played back at the end of
+ *    the frame. Because it is only bytes, a list can be saved and compared
+ *    against another build's, built on a worker thread and handed to the
+ *    drawing thread, or played again on another renderer.
+ ************************************************************************/
+
+#pragma once
+
+#include "position.h"   // for POSITION
+#include <vector>       // for VECTOR
+#include <iostream>     // for ISTREAM and OSTREAM
+#include <cstring>      // for MEMCPY
+#include <cstddef>      // for SIZE_T
+
+class TestCommandList;
+
+/************************************************************
+ * OPCODE
+ * What a command draws. The parameters that follow each one
+ * are listed beside it; every number is a float.
+ ************************************************************/
+enum Opcode : unsigned char
+{
+   OP_PROJECTILE,              // x y
+   OP_FRAGMENT,                // x y rotation
+   OP_CREW_DRAGON_CENTER,      // x y rotation
+   OP_SPUTNIK,                 // x y rotation
+   OP_GPS_CENTER,              // x y rotation
+   OP_EARTH,                   // x y rotation
+   OP_CREW_DRAGON_RIGHT,       // x y rotation offsetX offsetY
+   OP_CREW_DRAGON_LEFT,        // x y rotation offsetX offsetY
+   OP_GPS_RIGHT,               // x y rotation offsetX offsetY
+   OP_GPS_LEFT,                // x y rotation offsetX offsetY
+   OP_HUBBLE_TELESCOPE,        // x y rotation offsetX offsetY
+   OP_HUBBLE_COMPUTER,         // x y rotation offsetX offsetY
+   OP_HUBBLE_LEFT,             // x y rotation offsetX offsetY
+   OP_HUBBLE_RIGHT,            // x y rotation offsetX offsetY
+   OP_STARLINK_BODY,           // x y rotation offsetX offsetY
+   OP_STARLINK_ARRAY,          // x y rotation offsetX offsetY
+   OP_SHIP,                    // x y rotation
+   OP_SHIP_THRUST,             // x y rotation, then the two flame tips
+   OP_STARS,                   // count (4 bytes), every x y, then every phase (1 byte)
+   OP_TEXT,                    // x y, length (2 bytes), then the characters
+   OP_DETAIL,                  // the detail (1 byte)
+   OP_TRAIL,                   // count (4 bytes), then every x y
+   OP_HEAT_MAP                 // width height (2 bytes each), then a level per pixel (1 byte)
+};
+
+/************************************************************
+ * COMMAND LIST
+ * Draw calls recorded as bytes, to be played back later
+ ************************************************************/
+class CommandList
+{
+public:
+   friend TestCommandList;
+
+   CommandList() : commands(0) {}
+
+   // record one draw call
+   void part(Opcode opcode, const Position & center, double rotation);
+   void part(Opcode opcode, const Position & center, double rotation,
+             const Position & offset);
+   void projectile(const Position & center);
+   void ship(const Position & center, double rotation, const double * flame);
+   void stars(const Position * points, const unsigned char * phases, size_t num);
+   void trail(const Position * points, size_t num);
+   void heatMap(const unsigned char * levels, int width, int height);
+   void text(const Position & topLeft, const char * text, size_t length);
+   void detail(unsigned char detail);
+
+   // tack another list onto the end of this one
+   void append(const CommandList & rhs);
+
+   // call the draw* functions this list recorded
+   void replay() const;
+
+   // which command is the first that differs; count() when none do
+   size_t compare(const CommandList & rhs) const;
+
+   bool save(std::ostream & out) const;
+   bool load(std::istream & in);
+
+   void clear()             { bytes.clear(); commands = 0; }
+   size_t count() const     { return commands;     }
+   size_t size()  const     { return bytes.size(); }
+   bool empty()   const     { return commands == 0; }
+
+private:
+   // make room at the end for a command of a given size
+   unsigned char * grow(size_t size)
+   {
+      size_t at = bytes.size();
+      bytes.resize(at + size);
+      commands++;
+      return bytes.data() + at;
+   }
+
+   template <class T>
+   static unsigned char * put(unsigned char * p, T value)
+   {
+      memcpy(p, &value, sizeof(T));
+      return p + sizeof(T);
+   }
+
+   static unsigned char * putPixels(unsigned char * p, const Position & pt)
+   {
+      p = put(p, (float)pt.getPixelsX());
+      return put(p, (float)pt.getPixelsY());
+   }
+
+   template <class T>
+   T get(size_t & at) const
+   {
+      T value;
+      memcpy(&value, &bytes[at], sizeof(T));
+      at += sizeof(T);
+      return value;
+   }
+
+   Position getPixels(size_t & at) const;
+   size_t skip(size_t at) const;
+
+   std::vector<unsigned char> bytes;
+   size_t commands;
+};
@@ -0,0 +1,447 @@
+/***********************************************************************
+ * Source File:
+ *    Conjunction : Screening the population for close approaches
+ * Author:
+ *    Emilio Regino, Bradley Payne, Penelope Sanchez
+ * Summary:
+ *    The apogee/perigee, orbit path, and time filters followed by a
+ *    golden-section search for the time of closest approach.
+ ************************************************************************/
+
+#include "conjunction.h"   // for CONJUNCTION SCREENER
+#include "constants.h"     // for EARTH_RADIUS, GRAVITY
+#include <cmath>           // for SQRT, ATAN2, SINH, ...
+#include <algorithm>       // for SORT, MIN, MAX
+#include <cassert>         // for ASSERT
+
+// the earth's gravitational parameter. Our gravity is g (r / (r + h))^2,
+// which is exactly mu / d^2 with mu = g r^2
+const double MU = -GRAVITY * EARTH_RADIUS * EARTH_RADIUS;
+
+// how finely the orbit path filter walks around the orbit
+const int PATH_SAMPLES = 720;
+
+// how many distance samples refine() takes per orbit of the faster satellite
+const int SAMPLES_PER_ORBIT = 64;
+
+/**********************************************************************
+ * SCREEN
+ * Run every pair of live satellites through the filters, and find the
+ * time of closest approach for whatever survives.
+ **********************************************************************/
+std::vector<Conjunction> ConjunctionScreener :: screen(const std::list<Satellite *> & satellites)
+{
+   stats = ScreeningStats();
+
+   // elements for everything alive. A satellite with no angular momentum
+   // is falling straight into the earth and has no orbit to speak of
+   std::vector<Orbit> orbits;
+   for (auto satellite : satellites)
+      if (!satellite->isDead() && !satellite->hasExpired())
+      {
+         Orbit orbit = elements(*satellite);
+         if (orbit.p > 1.0)
+            orbits.push_back(orbit);
+      }
+
+   std::vector<Conjunction> conjunctions;
+   std::vector<Window> directions;
+   std::vector<Window> times;
+   for (size_t i = 0; i < orbits.size(); i++)
+      for (size_t j = i + 1; j < orbits.size(); j++)
+      {
+         stats.pairs++;
+
+         if (!filterApogeePerigee(orbits[i], orbits[j]))
+            continue;
+         stats.apogeePerigee++;
+
+         if (!filterOrbitPath(orbits[i], orbits[j], directions))
+            continue;
+         stats.orbitPath++;
+
+         if (!filterTime(orbits[i], orbits[j], directions, times))
+            continue;
+         stats.time++;
+
+         for (auto & window : times)
+            refine(orbits[i], orbits[j], window, conjunctions);
+      }
+
+   stats.encounters = conjunctions.size();
+   std::sort(conjunctions.begin(), conjunctions.end(),
+             [](const Conjunction & lhs, const Conjunction & rhs)
+             {
+                return lhs.tca < rhs.tca;
+             });
+   return conjunctions;
+}
+
+/**********************************************************************
+ * ELEMENTS
+ * Turn a position and velocity into two-body orbital elements
+ *
+ *    h = x vy - y vx
+ *    e = ((v^2 - mu / r) r - (r . v) v) / mu
+ *    p = h^2 / mu
+ *    a = p / (1 - e^2)
+ **********************************************************************/
+ConjunctionScreener::Orbit ConjunctionScreener :: elements(const Satellite & satellite)
+{
+   double x  = satellite.getPosition().getMetersX();
+   double y  = satellite.getPosition().getMetersY();
+   double vx = satellite.getVelocity().getX();
+   double vy = satellite.getVelocity().getY();
+
+   double r  = sqrt(x * x + y * y);
+   double v2 = vx * vx + vy * vy;
+   double h  = x * vy - y * vx;
+   double rv = x * vx + y * vy;
+   double ex = ((v2 - MU / r) * x - rv * vx) / MU;
+   double ey = ((v2 - MU / r) * y - rv * vy) / MU;
+
+   Orbit orbit;
+   orbit.id = satellite.getId();
+   orbit.p = h * h / MU;
+   orbit.e = sqrt(ex * ex + ey * ey);
+   orbit.direction = (h >= 0.0) ? 1.0 : -1.0;
+
+   // a circle has no perigee, so measure from where we are now
+   orbit.omega = (orbit.e > 1e-12) ? atan2(ey, ex) : atan2(y, x);
+
+   // a parabola is a hyperbola that is only just unbound
+   if (fabs(orbit.e - 1.0) < 1e-6)
+      orbit.e = 1.0 + 1e-6;
+
+   orbit.bound = orbit.e < 1.0;
+   orbit.a = orbit.p / (1.0 - orbit.e * orbit.e);
+   orbit.n = sqrt(MU / fabs(orbit.a * orbit.a * orbit.a));
+   orbit.perigee = orbit.p / (1.0 + orbit.e);
+   orbit.apogee = orbit.bound ? orbit.a * (1.0 + orbit.e) : INFINITY;
+
+   // where along the orbit we are right now
+   double nu = remainder(orbit.direction * (atan2(y, x) - orbit.omega), 2.0 * M_PI);
+   if (orbit.bound)
+   {
+      double E = 2.0 * atan2(sqrt(1.0 - orbit.e) * sin(nu / 2.0),
+                             sqrt(1.0 + orbit.e) * cos(nu / 2.0));
+      orbit.m0 = E - orbit.e * sin(E);
+   }
+   else
+   {
+      double H = 2.0 * atanh(sqrt((orbit.e - 1.0) / (orbit.e + 1.0)) * tan(nu / 2.0));
+      orbit.m0 = orbit.e * sinh(H) - H;
+   }
+
+   return orbit;
+}
+
+/**********************************************************************
+ * PROPAGATE
+ * Where a satellite will be t seconds from now, solving Kepler's
+ * equation with Newton's method
+ **********************************************************************/
+void ConjunctionScreener :: propagate(const Orbit & orbit, double t, double & x, double & y)
+{
+   double M = orbit.m0 + orbit.n * t;
+   double e = orbit.e;
+   double nu;
+   double r;
+
+   if (orbit.bound)
+   {
+      // M = E - e sin(E)
+      M = remainder(M, 2.0 * M_PI);
+      double E = (e > 0.8) ? M_PI * (M < 0.0 ? -1.0 : 1.0) : M;
+      for (int i = 0; i < 30; i++)
+      {
+         double step = (E - e * sin(E) - M) / (1.0 - e * cos(E));
+         E -= step;
+         if (fabs(step) < 1e-12)
+            break;
+      }
+      nu = 2.0 * atan2(sqrt(1.0 + e) * sin(E / 2.0), sqrt(1.0 - e) * cos(E / 2.0));
+      r = orbit.a * (1.0 - e * cos(E));
+   }
+   else
+   {
+      // M = e sinh(H) - H
+      double H = asinh(M / e);
+      for (int i = 0; i < 50; i++)
+      {
+         double step = (e * sinh(H) - H - M) / (e * cosh(H) - 1.0);
+         H -= step;
+         if (fabs(step) < 1e-12)
+            break;
+      }
+      nu = 2.0 * atan2(sqrt(e + 1.0) * sinh(H / 2.0), sqrt(e - 1.0) * cosh(H / 2.0));
+      r = orbit.a * (1.0 - e * cosh(H));
+   }
+
+   double theta = orbit.omega + orbit.direction * nu;
+   x = r * cos(theta);
+   y = r * sin(theta);
+}
+
+/**********************************************************************
+ * RADIUS
+ * How far from the center of the earth a bound orbit is in a given
+ * direction:  r = p / (1 + e cos(theta - omega))
+ **********************************************************************/
+double ConjunctionScreener :: radius(const Orbit & orbit, double theta)
+{
+   assert(orbit.bound);
+   return orbit.p / (1.0 + orbit.e * cos(theta - orbit.omega));
+}
+
+/**********************************************************************
+ * PERIOD
+ * Seconds per orbit. For an unbound orbit this is just the time scale
+ * of its mean motion.
+ **********************************************************************/
+double ConjunctionScreener :: period(const Orbit & orbit)
+{
+   return 2.0 * M_PI / orbit.n;
+}
+
+/**********************************************************************
+ * TIME TO DIRECTION
+ * How long until a bound orbit next points in a given direction
+ **********************************************************************/
+double ConjunctionScreener :: timeToDirection(const Orbit & orbit, double theta)
+{
+   assert(orbit.bound);
+   double nu = remainder(orbit.direction * (theta - orbit.omega), 2.0 * M_PI);
+   double E = 2.0 * atan2(sqrt(1.0 - orbit.e) * sin(nu / 2.0),
+                          sqrt(1.0 + orbit.e) * cos(nu / 2.0));
+   double M = E - orbit.e * sin(E);
+
+   double t = fmod((M - orbit.m0) / orbit.n, period(orbit));
+   return (t < 0.0) ? t + period(orbit) : t;
+}
+
+/**********************************************************************
+ * FILTER APOGEE PERIGEE
+ * Two satellites can only meet if the band of altitudes one sweeps
+ * through overlaps the other's
+ **********************************************************************/
+bool ConjunctionScreener :: filterApogeePerigee(const Orbit & orbit1, const Orbit & orbit2) const
+{
+   double lowest  = std::max(orbit1.perigee, orbit2.perigee);
+   double highest = std::min(orbit1.apogee,  orbit2.apogee);
+   return lowest - highest <= threshold;
+}
+
+/**********************************************************************
+ * FILTER ORBIT PATH
+ * Walk around both orbits and keep the directions where the curves come
+ * within the threshold of each other. Comparing radii direction by
+ * direction overstates the gap by at most 1 / cos(flight path angle),
+ * and the flight path angle never gets steeper than cos = sqrt(1 - e^2),
+ * so that factor keeps the filter conservative. Unbound orbits are not
+ * closed curves, so they skip straight to the fine search.
+ **********************************************************************/
+bool ConjunctionScreener :: filterOrbitPath(const Orbit & orbit1, const Orbit & orbit2,
+                                            std::vector<Window> & directions) const
+{
+   directions.clear();
+   if (!orbit1.bound || !orbit2.bound)
+   {
+      directions.push_back({ 0.0, 2.0 * M_PI });
+      return true;
+   }
+
+   double slant = std::min(sqrt(1.0 - orbit1.e * orbit1.e),
+                           sqrt(1.0 - orbit2.e * orbit2.e));
+
+   // the radii can change by at most this much between two samples
+   double step = 2.0 * M_PI / PATH_SAMPLES;
+   double slope1 = orbit1.e * orbit1.p / ((1.0 - orbit1.e) * (1.0 - orbit1.e));
+   double slope2 = orbit2.e * orbit2.p / ((1.0 - orbit2.e) * (1.0 - orbit2.e));
+   double pad = 0.5 * step * (slope1 + slope2);
+
+   bool close[PATH_SAMPLES];
+   int first = -1;
+   int numClose = 0;
+   for (int i = 0; i < PATH_SAMPLES; i++)
+   {
+      double theta = i * step;
+      double gap = fabs(radius(orbit1, theta) - radius(orbit2, theta)) - pad;
+      close[i] = slant * gap <= threshold;
+      if (close[i])
+         numClose++;
+      else if (first < 0)
+         first = i;
+   }
+
+   if (numClose == 0)
+      return false;
+   if (numClose == PATH_SAMPLES)
+   {
+      directions.push_back({ 0.0, 2.0 * M_PI });
+      return true;
+   }
+
+   // gather runs of close samples, starting just after a far one so a
+   // run that wraps past zero is not split in two
+   for (int k = 1; k <= PATH_SAMPLES; k++)
+   {
+      int i = (first + k) % PATH_SAMPLES;
+      if (!close[i])
+         continue;
+
+      double start = (first + k) * step - step / 2.0;
+      while (k < PATH_SAMPLES && close[(first + k + 1) % PATH_SAMPLES])
+         k++;
+      directions.push_back({ start, (first + k) * step + step / 2.0 });
+   }
+
+   return true;
+}
+
+/**********************************************************************
+ * FILTER TIME
+ * Find the times over the horizon when each satellite is passing
+ * through the close directions, and keep only the times when both are.
+ **********************************************************************/
+bool ConjunctionScreener :: filterTime(const Orbit & orbit1, const Orbit & orbit2,
+                                       const std::vector<Window> & directions,
+                                       std::vector<Window> & times) const
+{
+   times.clear();
+   if (directions.size() == 1 && directions[0].end - directions[0].start >= 2.0 * M_PI)
+   {
+      times.push_back({ 0.0, horizon });
+      return true;
+   }
+
+   // when is one satellite inside the close directions?
+   std::vector<Window> passes[2];
+   const Orbit * orbits[2] = { &orbit1, &orbit2 };
+   for (int i = 0; i < 2; i++)
+   {
+      const Orbit & orbit = *orbits[i];
+      double T = period(orbit);
+      for (auto & window : directions)
+      {
+         double enter = (orbit.direction > 0.0) ? window.start : window.end;
+         double leave = (orbit.direction > 0.0) ? window.end   : window.start;
+         double tEnter = timeToDirection(orbit, enter);
+         double duration = timeToDirection(orbit, leave) - tEnter;
+         if (duration < 0.0)
+            duration += T;
+
+         // start one orbit back in case we are already inside
+         for (double start = tEnter - T; start < horizon; start += T)
+         {
+            double begin = std::max(start, 0.0);
+            double end = std::min(start + duration, horizon);
+            if (end > begin)
+               passes[i].push_back({ begin, end });
+         }
+      }
+
+      std::sort(passes[i].begin(), passes[i].end(),
+                [](const Window & lhs, const Window & rhs)
+                {
+                   return lhs.start < rhs.start;
+                });
+   }
+
+   // intersect the two sorted lists
+   size_t i1 = 0;
+   size_t i2 = 0;
+   while (i1 < passes[0].size() && i2 < passes[1].size())
+   {
+      double begin = std::max(passes[0][i1].start, passes[1][i2].start);
+      double end   = std::min(passes[0][i1].end,   passes[1][i2].end);
+      if (end > begin)
+         times.push_back({ begin, end });
+
+      if (passes[0][i1].end < passes[1][i2].end)
+         i1++;
+      else
+         i2++;
+   }
+
+   return !times.empty();
+}
+
+/**********************************************************************
+ * REFINE
+ * Step through a window looking for dips in the distance between the
+ * two satellites, then narrow each dip down with a golden-section
+ * search. Every dip under the threshold is an encounter.
+ **********************************************************************/
+void ConjunctionScreener :: refine(const Orbit & orbit1, const Orbit & orbit2,
+                                   const Window & window,
+                                   std::vector<Conjunction> & conjunctions) const
+{
+   auto distance = [&](double t)
+   {
+      double x1, y1, x2, y2;
+      propagate(orbit1, t, x1, y1);
+      propagate(orbit2, t, x2, y2);
+      return sqrt((x1 - x2) * (x1 - x2) + (y1 - y2) * (y1 - y2));
+   };
+
+   double length = window.end - window.start;
+   double step = std::min(period(orbit1), period(orbit2)) / SAMPLES_PER_ORBIT;
+   step = std::min(step, length / 4.0);
+   if (step <= 0.0)
+      return;
+
+   // three samples in flight: before, current, and next
+   double tCurrent = window.start;
+   double dBefore = INFINITY;
+   double dCurrent = distance(tCurrent);
+   while (tCurrent < window.end)
+   {
+      double tNext = std::min(tCurrent + step, window.end);
+      double dNext = distance(tNext);
+
+      if (dCurrent <= dBefore && dCurrent < dNext)
+      {
+         // golden section between the neighboring samples
+         const double ratio = (sqrt(5.0) - 1.0) / 2.0;
+         double lo = std::max(tCurrent - step, window.start);
+         double hi = tNext;
+         double t1 = hi - ratio * (hi - lo);
+         double t2 = lo + ratio * (hi - lo);
+         double d1 = distance(t1);
+         double d2 = distance(t2);
+         for (int i = 0; i < 40; i++)
+         {
+            if (d1 < d2)
+            {
+               hi = t2; t2 = t1; d2 = d1;
+               t1 = hi - ratio * (hi - lo);
+               d1 = distance(t1);
+            }
+            else
+            {
+               lo = t1; t1 = t2; d1 = d2;
+               t2 = lo + ratio * (hi - lo);
+               d2 = distance(t2);
+            }
+         }
+
+         double tca = (d1 < d2) ? t1 : t2;
+         double miss = std::min(d1, d2);
+         if (miss <= threshold)
+            conjunctions.push_back({ std::min(orbit1.id, orbit2.id),
+                                     std::max(orbit1.id, orbit2.id),
+                                     tca, miss });
+      }
+
+      dBefore = dCurrent;
+      dCurrent = dNext;
+      tCurrent = tNext;
+   }
+
+   // the window may close while the pair is still getting nearer
+   if (dCurrent < dBefore && dCurrent <= threshold)
+      conjunctions.push_back({ std::min(orbit1.id, orbit2.id),
+                               std::max(orbit1.id, orbit2.id),
+                               window.end, dCurrent });
+}
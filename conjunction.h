@@ -0,0 +1,115 @@
+/***********************************************************************
+ * Header File:
+ *    Conjunction : Screening the population for close approaches
+ * Author:
+ *    Emilio Regino, Bradley Payne, Penelope Sanchez
+ * Summary:
+ *    Predicts which satellites will pass close to each other over a
+ *    horizon. Pairs run through the classic Hoots filters, cheapest
+ *    first, and only the survivors get a fine time-of-closest-approach
+ *    search:
+ *       1. apogee/perigee - do the radial shells even overlap?
+ *       2. orbit path     - do the two orbit curves come close anywhere?
+ *       3. time           - are both satellites near that spot at once?
+ *    Everything in the simulator orbits in one plane, so the orbit path
+ *    filter compares the two curves direction by direction rather than
+ *    at the line of nodes.
+ ************************************************************************/
+
+#pragma once
+
+#include "satellite.h"     // for SATELLITE
+#include <list>            // for LIST
+#include <vector>          // for VECTOR
+
+class TestConjunction;
+
+/**********************************************************************
+ * CONJUNCTION
+ * A predicted close approach between two satellites
+ **********************************************************************/
+struct Conjunction
+{
+   unsigned int id1;
+   unsigned int id2;
+   double tca;             // time of closest approach, seconds from now
+   double missDistance;    // center to center at the TCA, in meters
+};
+
+/**********************************************************************
+ * SCREENING STATS
+ * How many pairs survived each stage of the last screening
+ **********************************************************************/
+struct ScreeningStats
+{
+   size_t pairs;
+   size_t apogeePerigee;
+   size_t orbitPath;
+   size_t time;
+   size_t encounters;
+};
+
+/**********************************************************************
+ * CONJUNCTION SCREENER
+ * Finds every pair that comes within a threshold over a horizon
+ **********************************************************************/
+class ConjunctionScreener
+{
+public:
+   friend TestConjunction;
+
+   ConjunctionScreener(double horizon, double threshold) :
+      horizon(horizon), threshold(threshold), stats() {}
+
+   // screen a population, returning encounters sorted by TCA
+   std::vector<Conjunction> screen(const std::list<Satellite *> & satellites);
+
+   const ScreeningStats & getStats() const { return stats; }
+
+private:
+   /******************************************************
+    * ORBIT
+    * Two-body elements of a satellite, taken from its
+    * position and velocity right now
+    ******************************************************/
+   struct Orbit
+   {
+      unsigned int id;
+      double p;            // semi-latus rectum
+      double a;            // semi-major axis (negative when unbound)
+      double e;            // eccentricity
+      double omega;        // direction of perigee, radians
+      double direction;    // +1 counter-clockwise, -1 clockwise
+      double n;            // mean motion, radians per second
+      double m0;           // mean anomaly right now
+      double perigee;      // closest to the center of the earth
+      double apogee;       // farthest, infinite when unbound
+      bool   bound;        // ellipse rather than hyperbola
+   };
+
+   // a span of directions or of times
+   struct Window
+   {
+      double start;
+      double end;
+   };
+
+   static Orbit elements(const Satellite & satellite);
+   static void propagate(const Orbit & orbit, double t, double & x, double & y);
+   static double radius(const Orbit & orbit, double theta);
+   static double period(const Orbit & orbit);
+   static double timeToDirection(const Orbit & orbit, double theta);
+
+   bool filterApogeePerigee(const Orbit & orbit1, const Orbit & orbit2) const;
+   bool filterOrbitPath(const Orbit & orbit1, const Orbit & orbit2,
+                        std::vector<Window> & directions) const;
+   bool filterTime(const Orbit & orbit1, const Orbit & orbit2,
+                   const std::vector<Window> & directions,
+                   std::vector<Window> & times) const;
+   void refine(const Orbit & orbit1, const Orbit & orbit2, const Window & window,
+               std::vector<Conjunction> & conjunctions) const;
+
+   double horizon;         // how far ahead to look, in seconds
+   double threshold;       // how close counts as an encounter, in meters
+   ScreeningStats stats;
+};
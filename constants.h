@@ -16,3 +16,13 @@ const double TIME_PER_FRAME = TIME_DILATION / FRAME_RATE;
 const double EARTH_RADIUS = 6378000.0;
 const double ANGULAR_VELOCITY = 0.2;
 const double GRAVITY = -9.80665;
+const double MAX_ACCELERATION = 9.80665 + 3.0; /* surface gravity plus ship thrust */
+const unsigned int EARTH_ID = 0;
+const int KINETIC_LIMIT = 1000; /* most satellites before collisions switch to the grid */
+const double DRAW_MARGIN = 16.0; /* pixels a drawing reaches past its radius: arrays, the flame */
+const double DETAIL_SIMPLE_PIXELS = 2.0; /* radius on screen below which a part is just a box */
+const double DETAIL_POINT_PIXELS = 0.5;  /* and below which it is just a dot */
+const double STATS_MARGIN = 20.0; /* pixels between the render stats and the corner of the screen */
+const int TRAIL_LENGTH = 64;  /* positions kept in each orbit trail, one per frame */
+const int TRAIL_BUDGET = 256; /* most satellites with a trail at once */
+const int HEAT_MAP_THRESHOLD = 50000; /* more satellites than this are drawn as a heat map */
@@ -0,0 +1,31 @@
+/***********************************************************************
+ * Header File:
+ *    Controls : The keys the simulation listens to
+ * Author:
+ *    Emilio Regino, Bradley Payne, Penelope Sanchez
+ * Summary:
+ *    A copy of the keys that matter, taken on the display thread, so
+ *    the simulation can act on them without touching the window
+ ************************************************************************/
+
+#pragma once
+
+#include "uiInteract.h"    // for INTERFACE
+
+/**********************************************************************
+ * CONTROLS
+ * Which keys were down when the copy was taken
+ **********************************************************************/
+struct Controls
+{
+   Controls() : up(false), down(false), left(false), right(false), space(false) {}
+   Controls(const Interface * pUI) :
+      up(pUI->isUp()), down(pUI->isDown()), left(pUI->isLeft()),
+      right(pUI->isRight()), space(pUI->isSpace()) {}
+
+   bool up;
+   bool down;
+   bool left;
+   bool right;
+   bool space;
+};
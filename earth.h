@@ -17,10 +17,11 @@ class Earth
 {
 public:
    // constructors
-   Earth(): position(0.0, 0.0), angle(0.0), radius(EARTH_RADIUS) {}
+   Earth(): position(0.0, 0.0), angle(0.0), lastAngle(0.0), radius(EARTH_RADIUS) {}
    
    // getters
-   double getAngle() { return angle; }
+   double getAngle() const { return angle; }
+   double getLastAngle() const { return lastAngle; }
    Position getPosition() { return position; }
    double getRadius() {return radius; }
    
@@ -28,10 +29,15 @@ public:
    void draw() const { drawEarth(position, angle); }
    
    // modifers
-   void update() { angle += -(2.0 * M_PI / 30.0) * (TIME_DILATION / 86400.0); }
+   void update()
+   {
+      lastAngle = angle;
+      angle += -(2.0 * M_PI / 30.0) * (TIME_DILATION / 86400.0);
+   }
    
 private:
    Position position; // the position of the earth
    double angle;      // the angle of the earth in radians
+   double lastAngle;  // before the last update
    double radius;     // the radius of the earth in meters
 };
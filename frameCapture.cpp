@@ -0,0 +1,289 @@
+/***********************************************************************
+ * Source File:
+ *    Frame Capture : Record frames to a video file
+ * Author:
+ *    Emilio Regino, Bradley Payne, Penelope Sanchez
+ * Summary:
+ *    The drawing thread and the writer share only the ring of slots and
+ *    the lock guarding where it starts and how much is in it. Each holds
+ *    the lock just long enough to move a slot across; the pixels are
+ *    copied and converted outside it.
+ ************************************************************************/
+
+#ifdef __APPLE__
+#define GL_SILENCE_DEPRECATION
+#include <openGL/gl.h>    // Main OpenGL library
+#endif // __APPLE__
+
+#ifdef __linux__
+#include <GL/gl.h>        // Main OpenGL library
+#endif // __linux__
+
+#ifdef _WIN32
+#include <stdio.h>
+#include <stdlib.h>
+#include <GL/glut.h>         // OpenGL library we copied
+#endif // _WIN32
+
+#include "frameCapture.h"       // for FRAME CAPTURE
+#include "softwareRenderer.h"   // for SOFTWARE RENDERER
+#include "glRenderer.h"         // for GL RENDERER
+#include <cstring>              // for MEMCPY
+#include <algorithm>            // for MIN and MAX
+#include <cassert>              // for ASSERT
+
+/**********************************************************************
+ * CONSTRUCTOR
+ * Open the video and write its header, set aside every buffer, and
+ * start the writer
+ **********************************************************************/
+FrameCapture :: FrameCapture(const std::string & path, CaptureFormat format,
+                             int width, int height, int rate, size_t depth) :
+   path(path), format(format), width(width), height(height), pFile(NULL),
+   slots(depth < 1 ? 1 : depth), head(0), queued(0), stopping(false),
+   written(0), failed(false)
+{
+   assert(width > 0 && height > 0);
+   for (Slot & slot : slots)
+   {
+      slot.rgba.resize((size_t)width * height * 4);
+      slot.bottomUp = false;
+   }
+
+   if (format == CAPTURE_Y4M)
+   {
+      // full range, with each pair of rows and columns sharing a color
+      int chromaWidth = (width + 1) / 2;
+      int chromaHeight = (height + 1) / 2;
+      planes.resize((size_t)width * height + 2 * (size_t)chromaWidth * chromaHeight);
+      pFile = fopen(path.c_str(), "wb");
+      if (pFile == NULL ||
+          fprintf(pFile, "YUV4MPEG2 W%d H%d F%d:1 Ip A1:1 C420jpeg\n",
+                  width, height, rate) < 0)
+         failed.store(true);
+   }
+   else
+   {
+      planes.resize((size_t)width * 3);
+      name.resize(path.size() + 32);
+   }
+
+   thread = std::thread(&FrameCapture::run, this);
+}
+
+/**********************************************************************
+ * DESTRUCTOR
+ **********************************************************************/
+FrameCapture :: ~FrameCapture()
+{
+   finish();
+}
+
+/**********************************************************************
+ * FINISH
+ * Let the writer empty the queue and stop, then close the video, so
+ * good() covers every frame
+ **********************************************************************/
+void FrameCapture :: finish()
+{
+   if (!thread.joinable())
+      return;
+   {
+      std::lock_guard<std::mutex> guard(lock);
+      stopping = true;
+   }
+   changed.notify_all();
+   thread.join();
+   if (pFile != NULL && fclose(pFile) != 0)
+      failed.store(true);
+   pFile = NULL;
+}
+
+/**********************************************************************
+ * ACQUIRE
+ * The slot just past the queued ones. The writer never touches it
+ * until it is submitted.
+ **********************************************************************/
+unsigned char * FrameCapture :: acquire()
+{
+   std::unique_lock<std::mutex> guard(lock);
+   changed.wait(guard, [this] { return queued < slots.size(); });
+   return slots[(head + queued) % slots.size()].rgba.data();
+}
+
+/**********************************************************************
+ * SUBMIT
+ **********************************************************************/
+void FrameCapture :: submit(bool bottomUp)
+{
+   {
+      std::lock_guard<std::mutex> guard(lock);
+      assert(queued < slots.size());
+      slots[(head + queued) % slots.size()].bottomUp = bottomUp;
+      queued++;
+   }
+   changed.notify_all();
+}
+
+/**********************************************************************
+ * CAPTURE
+ **********************************************************************/
+void FrameCapture :: capture(const unsigned char * rgba, bool bottomUp)
+{
+   memcpy(acquire(), rgba, (size_t)width * height * 4);
+   submit(bottomUp);
+}
+
+/**********************************************************************
+ * RUN
+ * Write the slot at the head of the queue, and only then let it go, so
+ * it is not filled again while still being read. Once told to stop,
+ * finish whatever is queued first.
+ **********************************************************************/
+void FrameCapture :: run()
+{
+   size_t number = 0;
+   while (true)
+   {
+      size_t at;
+      {
+         std::unique_lock<std::mutex> guard(lock);
+         changed.wait(guard, [this] { return queued > 0 || stopping; });
+         if (queued == 0)
+            return;
+         at = head;
+      }
+
+      bool wrote = (format == CAPTURE_Y4M) ? writeY4M(slots[at])
+                                           : writePPM(slots[at], number);
+      if (!wrote)
+         failed.store(true);
+      number++;
+      written.store(number, std::memory_order_relaxed);
+
+      {
+         std::lock_guard<std::mutex> guard(lock);
+         head = (head + 1) % slots.size();
+         queued--;
+      }
+      changed.notify_all();
+   }
+}
+
+/**********************************************************************
+ * TO BYTE
+ * Pure blue or red lands just past the top of U or V
+ **********************************************************************/
+static inline unsigned char toByte(int value)
+{
+   return (unsigned char)std::min(std::max(value, 0), 255);
+}
+
+/**********************************************************************
+ * WRITE Y4M
+ * One frame: Y for every pixel, then U and V for every two by two
+ * block, averaged. The weights are BT.601's, in 256ths.
+ **********************************************************************/
+bool FrameCapture :: writeY4M(const Slot & slot)
+{
+   if (pFile == NULL)
+      return false;
+
+   int chromaWidth = (width + 1) / 2;
+   int chromaHeight = (height + 1) / 2;
+   unsigned char * pY = planes.data();
+   unsigned char * pU = pY + (size_t)width * height;
+   unsigned char * pV = pU + (size_t)chromaWidth * chromaHeight;
+
+   for (int y = 0; y < height; y++)
+   {
+      const unsigned char * pixel = row(slot, width, height, y);
+      for (int x = 0; x < width; x++, pixel += 4)
+         *pY++ = (unsigned char)((77 * pixel[0] + 150 * pixel[1] + 29 * pixel[2] + 128) >> 8);
+   }
+
+   for (int cy = 0; cy < chromaHeight; cy++)
+   {
+      // an odd last row or column stands in for its missing neighbor
+      const unsigned char * top = row(slot, width, height, 2 * cy);
+      const unsigned char * bottom = row(slot, width, height, std::min(2 * cy + 1, height - 1));
+      for (int cx = 0; cx < chromaWidth; cx++)
+      {
+         int left = 8 * cx;
+         int right = 4 * std::min(2 * cx + 1, width - 1);
+         int r = top[left]     + top[right]     + bottom[left]     + bottom[right];
+         int g = top[left + 1] + top[right + 1] + bottom[left + 1] + bottom[right + 1];
+         int b = top[left + 2] + top[right + 2] + bottom[left + 2] + bottom[right + 2];
+         *pU++ = toByte(((-43 * r - 85 * g + 128 * b + 512) >> 10) + 128);
+         *pV++ = toByte(((128 * r - 107 * g - 21 * b + 512) >> 10) + 128);
+      }
+   }
+
+   return fputs("FRAME\n", pFile) >= 0 &&
+          fwrite(planes.data(), 1, planes.size(), pFile) == planes.size();
+}
+
+/**********************************************************************
+ * WRITE PPM
+ * One picture, a row at a time, dropping the alpha
+ **********************************************************************/
+bool FrameCapture :: writePPM(const Slot & slot, size_t number)
+{
+   snprintf(name.data(), name.size(), "%s%06zu.ppm", path.c_str(), number);
+   FILE * pPicture = fopen(name.data(), "wb");
+   if (pPicture == NULL)
+      return false;
+
+   bool wrote = fprintf(pPicture, "P6\n%d %d\n255\n", width, height) > 0;
+   for (int y = 0; wrote && y < height; y++)
+   {
+      const unsigned char * pixel = row(slot, width, height, y);
+      for (int x = 0; x < width; x++, pixel += 4)
+         memcpy(&planes[x * 3], pixel, 3);
+      wrote = fwrite(planes.data(), 3, width, pPicture) == (size_t)width;
+   }
+   return (fclose(pPicture) == 0) && wrote;
+}
+
+/**********************************************************************
+ * CAPTURE RENDERER : CONSTRUCTOR
+ **********************************************************************/
+CaptureRenderer :: CaptureRenderer(FrameCapture & capture, CaptureSource source,
+                                   int workers) : capture(capture)
+{
+   if (source == CAPTURE_OFFSCREEN)
+      pOffscreen.reset(new SoftwareRenderer(capture.getWidth(), capture.getHeight(), workers));
+   else
+      pWindow.reset(new GLRenderer);
+}
+
+/**********************************************************************
+ * CAPTURE RENDERER : DESTRUCTOR
+ * Here, where the renderers are whole types
+ **********************************************************************/
+CaptureRenderer :: ~CaptureRenderer()
+{
+}
+
+/**********************************************************************
+ * CAPTURE RENDERER : RENDER
+ * Draw the frame, then queue it. Read back from the window, it goes
+ * straight into the capture's slot; the window is assumed to be the
+ * capture's size.
+ **********************************************************************/
+void CaptureRenderer :: render(const Frame & frame)
+{
+   if (pOffscreen)
+   {
+      pOffscreen->render(frame);
+      capture.capture(pOffscreen->getPixels(), false /*bottomUp*/);
+   }
+   else
+   {
+      pWindow->render(frame);
+      glPixelStorei(GL_PACK_ALIGNMENT, 1);
+      glReadPixels(0, 0, capture.getWidth(), capture.getHeight(),
+                   GL_RGBA, GL_UNSIGNED_BYTE, capture.acquire());
+      capture.submit(true /*bottomUp*/);
+   }
+}
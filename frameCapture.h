@@ -0,0 +1,143 @@
+/***********************************************************************
+ * Header File:
+ *    Frame Capture : Record frames to a video file
+ * Author:
+ *    Emilio Regino, Bradley Payne, Penelope Sanchez
+ * Summary:
+ *    Filming the window is at the mercy of whatever else the machine is
+ *    doing. Instead each finished frame is handed over as RGBA pixels,
+ *    either painted offscreen by the software renderer or read back
+ *    from the window. The frames wait in a short queue, and a thread of
+ *    their own writes them out as one Y4M video or as a numbered run of
+ *    PPM pictures. Every buffer is set aside up front, so recording
+ *    allocates nothing from one frame to the next.
+ ************************************************************************/
+
+#pragma once
+
+#include "renderer.h"    // for RENDERER
+#include "constants.h"   // for FRAME_RATE
+#include <vector>        // for VECTOR
+#include <string>        // for STRING
+#include <memory>        // for UNIQUE_PTR
+#include <atomic>        // for ATOMIC
+#include <thread>        // for THREAD
+#include <mutex>         // for MUTEX
+#include <condition_variable>   // for CONDITION_VARIABLE
+#include <cstdio>        // for FILE
+
+class TestFrameCapture;
+class SoftwareRenderer;
+class GLRenderer;
+
+// how many frames can wait for the writer before drawing has to
+const size_t CAPTURE_DEPTH = 4;
+
+// how the frames are written
+enum CaptureFormat
+{
+   CAPTURE_Y4M,   // one file, 4:2:0, which most players and encoders read
+   CAPTURE_PPM    // a picture per frame: the path then a six digit number
+};
+
+/************************************************************
+ * FRAME CAPTURE
+ * A bounded queue of frames and the thread writing them. The
+ * frames are given by one thread, the one drawing.
+ ************************************************************/
+class FrameCapture
+{
+public:
+   friend TestFrameCapture;
+
+   FrameCapture(const std::string & path, CaptureFormat format, int width, int height,
+                int rate = (int)FRAME_RATE, size_t depth = CAPTURE_DEPTH);
+
+   // write whatever is still queued, then stop. Nothing more may be
+   // captured after finish(), which the destructor calls if need be.
+   ~FrameCapture();
+   void finish();
+
+   // somewhere to put the next frame, width by height by four bytes.
+   // Waits while the queue is full.
+   unsigned char * acquire();
+
+   // queue the frame from acquire() to be written. Rows are top first
+   // unless bottomUp, as OpenGL reads them back.
+   void submit(bool bottomUp);
+
+   // copy a frame in and queue it
+   void capture(const unsigned char * rgba, bool bottomUp);
+
+   // opened, and every frame written so far went through
+   bool good() const { return !failed.load(std::memory_order_relaxed); }
+
+   size_t getWritten() const { return written.load(std::memory_order_relaxed); }
+   int getWidth()  const { return width;  }
+   int getHeight() const { return height; }
+
+private:
+   struct Slot
+   {
+      std::vector<unsigned char> rgba;
+      bool bottomUp;
+   };
+
+   void run();
+   bool writeY4M(const Slot & slot);
+   bool writePPM(const Slot & slot, size_t number);
+
+   // the pixel of a frame in the given row counting from the top
+   static const unsigned char * row(const Slot & slot, int width, int height, int y)
+   {
+      return slot.rgba.data() + (size_t)(slot.bottomUp ? height - 1 - y : y) * width * 4;
+   }
+
+   std::string path;
+   CaptureFormat format;
+   int width;
+   int height;
+   FILE * pFile;                      // the video; NULL for pictures
+
+   // the slots are a ring: the queued ones start at head, and the one
+   // being filled comes right after them
+   std::vector<Slot> slots;
+   size_t head;
+   size_t queued;
+   bool stopping;
+   std::mutex lock;
+   std::condition_variable changed;
+
+   // the writer's, set aside once
+   std::vector<unsigned char> planes;   // Y, then U, then V
+   std::vector<char> name;              // a picture's file name
+
+   std::atomic<size_t> written;
+   std::atomic<bool> failed;
+   std::thread thread;
+};
+
+// where a capture renderer gets its pixels
+enum CaptureSource
+{
+   CAPTURE_OFFSCREEN,   // painted by a software renderer the capture's size
+   CAPTURE_WINDOW       // drawn in the window as usual, then read back
+};
+
+/************************************************************
+ * CAPTURE RENDERER
+ * Draws each frame and hands the picture to a capture
+ ************************************************************/
+class CaptureRenderer : public Renderer
+{
+public:
+   CaptureRenderer(FrameCapture & capture, CaptureSource source, int workers = 1);
+   ~CaptureRenderer();
+
+   void render(const Frame & frame);
+
+private:
+   FrameCapture & capture;
+   std::unique_ptr<SoftwareRenderer> pOffscreen;   // one or the other
+   std::unique_ptr<GLRenderer> pWindow;
+};
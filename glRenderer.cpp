@@ -0,0 +1,216 @@
+/***********************************************************************
+ * Source File:
+ *    GL Renderer : Draw frames with OpenGL
+ * Author:
+ *    Emilio Regino, Bradley Payne, Penelope Sanchez
+ * Summary:
+ *    Each array of the frame is handed to OpenGL as a client-side
+ *    vertex array, so a frame costs a handful of calls however much is
+ *    in it.
+ ************************************************************************/
+
+#ifdef __APPLE__
+#define GL_SILENCE_DEPRECATION
+#include <openGL/gl.h>    // Main OpenGL library
+#include <GLUT/glut.h>    // Second OpenGL library
+#endif // __APPLE__
+
+#ifdef __linux__
+#include <GL/gl.h>        // Main OpenGL library
+#include <GL/glut.h>      // Second OpenGL library
+#endif // __linux__
+
+#ifdef _WIN32
+#include <stdio.h>
+#include <stdlib.h>
+#include <GL/glut.h>         // OpenGL library we copied 
+#endif // _WIN32
+
+#include "glRenderer.h"   // for GL RENDERER
+
+/*************************************************************************
+ * CONSTRUCTOR
+ *************************************************************************/
+GLRenderer :: GLRenderer() : atlas(GLUT_BITMAP_HELVETICA_12),  // also try _18
+                             spriteTexture(0), spriteVersion(0)
+{
+}
+
+/*************************************************************************
+ * DRAW ARRAY
+ * Hand one array of the frame to OpenGL
+ *************************************************************************/
+static void drawArray(GLenum mode, const std::vector<Vertex> & vertices)
+{
+   if (vertices.empty())
+      return;
+   glVertexPointer(2, GL_FLOAT, sizeof(Vertex), &vertices[0].x);
+   glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(Vertex), vertices[0].rgba);
+   glDrawArrays(mode, 0, (GLsizei)vertices.size());
+}
+
+/*************************************************************************
+ * DRAW IMAGE
+ * Load the image into a texture and put it on one quad, blended over
+ * whatever is already there
+ *************************************************************************/
+static void drawImage(const Image & image)
+{
+   static GLuint texture = 0;
+   if (texture == 0)
+      glGenTextures(1, &texture);
+
+   glBindTexture(GL_TEXTURE_2D, texture);
+   glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+   glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+   glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+   glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, image.width, image.height, 0,
+                GL_RGBA, GL_UNSIGNED_BYTE, image.rgba.data());
+
+   glEnable(GL_TEXTURE_2D);
+   glEnable(GL_BLEND);
+   glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+   glColor4f(1.0f, 1.0f, 1.0f, 1.0f);
+
+   // row 0 of the image is its top
+   GLfloat left = image.x, right = image.x + image.width;
+   GLfloat top = image.y, bottom = image.y - image.height;
+   glBegin(GL_QUADS);
+   glTexCoord2f(0.0f, 0.0f);  glVertex2f(left,  top);
+   glTexCoord2f(1.0f, 0.0f);  glVertex2f(right, top);
+   glTexCoord2f(1.0f, 1.0f);  glVertex2f(right, bottom);
+   glTexCoord2f(0.0f, 1.0f);  glVertex2f(left,  bottom);
+   glEnd();
+
+   glDisable(GL_BLEND);
+   glDisable(GL_TEXTURE_2D);
+}
+
+/*************************************************************************
+ * RENDER
+ * Points, then the image, trails, triangles, sprites, lines, and text.
+ * Only the image and the trails are see-through.
+ *************************************************************************/
+void GLRenderer :: render(const Frame & frame)
+{
+   glEnableClientState(GL_VERTEX_ARRAY);
+   glEnableClientState(GL_COLOR_ARRAY);
+
+   drawArray(GL_POINTS,    frame.points);
+   if (frame.image.width > 0 && frame.image.height > 0)
+      drawImage(frame.image);
+   if (!frame.trails.empty())
+   {
+      glEnable(GL_BLEND);
+      glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+      drawArray(GL_LINES,  frame.trails);
+      glDisable(GL_BLEND);
+   }
+   drawArray(GL_TRIANGLES, frame.triangles);
+   if (frame.pAtlas && !frame.sprites.empty())
+      drawSprites(frame);
+   drawArray(GL_LINES,     frame.lines);
+
+   glDisableClientState(GL_COLOR_ARRAY);
+   glDisableClientState(GL_VERTEX_ARRAY);
+
+   // text is drawn with a simple bitmap font, from the atlas
+   if (!frame.texts.empty())
+   {
+      if (!atlas.isBuilt())
+         atlas.build();
+      layoutText(frame);
+      atlas.draw(quads);
+   }
+}
+
+/*************************************************************************
+ * DRAW SPRITES
+ * One textured quad per sprite, all in one call. The atlas is loaded
+ * again only when it changes. What is see-through in it is left out by
+ * the alpha test, so nothing is blended. Called with the vertex array
+ * on, and leaves it that way.
+ *************************************************************************/
+void GLRenderer :: drawSprites(const Frame & frame)
+{
+   const Image & image = *frame.pAtlas;
+   if (spriteTexture == 0)
+      glGenTextures(1, &spriteTexture);
+   glBindTexture(GL_TEXTURE_2D, spriteTexture);
+   if (spriteVersion != frame.atlasVersion)
+   {
+      glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+      glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+      glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+      glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, image.width, image.height, 0,
+                   GL_RGBA, GL_UNSIGNED_BYTE, image.rgba.data());
+      spriteVersion = frame.atlasVersion;
+   }
+
+   // row 0 of the atlas is its top, and the first row of the texture
+   float du = 1.0f / image.width;
+   float dv = 1.0f / image.height;
+   spriteQuads.resize(frame.sprites.size() * 4);
+   GlyphVertex * pQuad = spriteQuads.data();
+   for (const Sprite & sprite : frame.sprites)
+   {
+      float right  = sprite.x + sprite.width;
+      float bottom = sprite.y - sprite.height;
+      float u0 = sprite.u * du;
+      float v0 = sprite.v * dv;
+      float u1 = (sprite.u + sprite.width) * du;
+      float v1 = (sprite.v + sprite.height) * dv;
+      *pQuad++ = { sprite.x, sprite.y, u0, v0 };
+      *pQuad++ = { right,    sprite.y, u1, v0 };
+      *pQuad++ = { right,    bottom,   u1, v1 };
+      *pQuad++ = { sprite.x, bottom,   u0, v1 };
+   }
+
+   glDisableClientState(GL_COLOR_ARRAY);
+   glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+   glEnable(GL_TEXTURE_2D);
+   glEnable(GL_ALPHA_TEST);
+   glAlphaFunc(GL_GREATER, 0.5f);
+   glColor4f(1.0f, 1.0f, 1.0f, 1.0f);
+   glVertexPointer(2, GL_FLOAT, sizeof(GlyphVertex), &spriteQuads[0].x);
+   glTexCoordPointer(2, GL_FLOAT, sizeof(GlyphVertex), &spriteQuads[0].u);
+   glDrawArrays(GL_QUADS, 0, (GLsizei)spriteQuads.size());
+   glDisable(GL_ALPHA_TEST);
+   glDisable(GL_TEXTURE_2D);
+   glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+   glEnableClientState(GL_COLOR_ARRAY);
+}
+
+/*************************************************************************
+ * LAYOUT TEXT
+ * Bring the quads up to date with the frame's text. Only lines that
+ * differ from the same line last frame are laid out again, and when
+ * none do the quads are left just as they were.
+ *************************************************************************/
+void GLRenderer :: layoutText(const Frame & frame)
+{
+   bool changed = lines.size() != frame.texts.size();
+   lines.resize(frame.texts.size());
+   for (size_t i = 0; i < frame.texts.size(); i++)
+   {
+      const Text & text = frame.texts[i];
+      CachedLine & line = lines[i];
+      if (line.x == text.x && line.y == text.y &&
+          line.text.compare(0, std::string::npos,
+                            frame.characters, text.first, text.length) == 0)
+         continue;
+
+      line.x = text.x;
+      line.y = text.y;
+      line.text.assign(frame.characters, text.first, text.length);
+      line.quads.clear();
+      atlas.layout(text.x, text.y, line.text.data(), line.text.size(), line.quads);
+      changed = true;
+   }
+
+   if (!changed)
+      return;
+   quads.clear();
+   for (const CachedLine & line : lines)
+      quads.insert(quads.end(), line.quads.begin(), line.quads.end());
+}
@@ -0,0 +1,50 @@
+/***********************************************************************
+ * Header File:
+ *    GL Renderer : Draw frames with OpenGL
+ * Author:
+ *    Emilio Regino, Bradley Payne, Penelope Sanchez
+ * Summary:
+ *    Puts a frame on the screen in the window GLUT opened, one draw
+ *    call per primitive. Text is drawn from a glyph atlas, and a line
+ *    that reads the same as last frame is not laid out again.
+ ************************************************************************/
+
+#pragma once
+
+#include "renderer.h"     // for RENDERER
+#include "glyphAtlas.h"   // for GLYPH ATLAS
+#include <string>         // for STRING
+#include <vector>         // for VECTOR
+
+/************************************************************
+ * GL RENDERER
+ * The renderer for the window
+ ************************************************************/
+class GLRenderer : public Renderer
+{
+public:
+   GLRenderer();
+
+   void render(const Frame & frame);
+
+private:
+   // one line of the last frame's text, already laid out
+   struct CachedLine
+   {
+      float x;
+      float y;
+      std::string text;
+      std::vector<GlyphVertex> quads;
+   };
+
+   void layoutText(const Frame & frame);
+   void drawSprites(const Frame & frame);
+
+   GlyphAtlas atlas;                  // the font, built on first use
+   std::vector<CachedLine> lines;     // kept from frame to frame
+   std::vector<GlyphVertex> quads;    // every line's, end to end
+
+   unsigned int spriteTexture;        // the frame's atlas, once loaded
+   unsigned int spriteVersion;        // which version of it is loaded
+   std::vector<GlyphVertex> spriteQuads;
+};
@@ -0,0 +1,170 @@
+/***********************************************************************
+ * Source File:
+ *    Glyph Atlas : A bitmap font rasterized once into a texture
+ * Author:
+ *    Emilio Regino, Bradley Payne, Penelope Sanchez
+ * Summary:
+ *    GLUT does not hand out its font bitmaps, so the atlas is made the
+ *    only portable way: by having GLUT draw each glyph into a corner of
+ *    the window and reading the pixels back.
+ ************************************************************************/
+
+#ifdef __APPLE__
+#define GL_SILENCE_DEPRECATION
+#include <openGL/gl.h>    // Main OpenGL library
+#include <GLUT/glut.h>    // Second OpenGL library
+#endif // __APPLE__
+
+#ifdef __linux__
+#include <GL/gl.h>        // Main OpenGL library
+#include <GL/glut.h>      // Second OpenGL library
+#endif // __linux__
+
+#ifdef _WIN32
+#include <stdio.h>
+#include <stdlib.h>
+#include <GL/glut.h>         // OpenGL library we copied
+#endif // _WIN32
+
+#include "glyphAtlas.h"   // for GLYPH ATLAS
+#include <algorithm>      // for MIN and MAX
+
+const int GLYPH_ROWS = (GLYPH_LAST - GLYPH_FIRST + GLYPH_COLUMNS) / GLYPH_COLUMNS;
+const int ATLAS_WIDTH = GLYPH_COLUMNS * GLYPH_CELL;
+const int ATLAS_HEIGHT = GLYPH_ROWS * GLYPH_CELL;
+
+/*************************************************************************
+ * BUILD
+ * Draw every glyph white on black in the bottom left cell of the window,
+ * read it back into its cell of the atlas, and finally clear the corner
+ * to how it was found. The screen is assumed to be in pixels with the
+ * origin at its center, as everything else drawn is.
+ *************************************************************************/
+void GlyphAtlas :: build()
+{
+   GLint viewport[4];
+   GLfloat clearColor[4];
+   glGetIntegerv(GL_VIEWPORT, viewport);
+   glGetFloatv(GL_COLOR_CLEAR_VALUE, clearColor);
+
+   std::vector<unsigned char> rgba((size_t)ATLAS_WIDTH * ATLAS_HEIGHT * 4, 255);
+   std::vector<unsigned char> cell((size_t)GLYPH_CELL * GLYPH_CELL * 4);
+
+   glEnable(GL_SCISSOR_TEST);
+   glScissor(viewport[0], viewport[1], GLYPH_CELL, GLYPH_CELL);
+   glPixelStorei(GL_PACK_ALIGNMENT, 1);
+   glColor3f(1.0f, 1.0f, 1.0f);
+   for (int c = GLYPH_FIRST; c <= GLYPH_LAST; c++)
+   {
+      int index = c - GLYPH_FIRST;
+
+      glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+      glClear(GL_COLOR_BUFFER_BIT);
+      glRasterPos2f((GLfloat)(GLYPH_ORIGIN - viewport[2] / 2.0),
+                    (GLfloat)(GLYPH_ORIGIN - viewport[3] / 2.0));
+      glutBitmapCharacter(pFont, c);
+      glReadPixels(viewport[0], viewport[1], GLYPH_CELL, GLYPH_CELL,
+                   GL_RGBA, GL_UNSIGNED_BYTE, cell.data());
+
+      // rows come back bottom first, which is how the atlas keeps them
+      int left = (index % GLYPH_COLUMNS) * GLYPH_CELL;
+      int bottom = (index / GLYPH_COLUMNS) * GLYPH_CELL;
+      int minX = GLYPH_CELL, minY = GLYPH_CELL, maxX = -1, maxY = -1;
+      for (int y = 0; y < GLYPH_CELL; y++)
+         for (int x = 0; x < GLYPH_CELL; x++)
+         {
+            unsigned char coverage = cell[((size_t)y * GLYPH_CELL + x) * 4];
+            rgba[(((size_t)bottom + y) * ATLAS_WIDTH + left + x) * 4 + 3] = coverage;
+            if (coverage)
+            {
+               minX = std::min(minX, x);
+               minY = std::min(minY, y);
+               maxX = std::max(maxX, x);
+               maxY = std::max(maxY, y);
+            }
+         }
+
+      Glyph & glyph = glyphs[index];
+      glyph.left = minX;
+      glyph.bottom = minY;
+      glyph.width = maxX + 1 - std::min(minX, maxX + 1);
+      glyph.height = maxY + 1 - std::min(minY, maxY + 1);
+      glyph.advance = glutBitmapWidth(pFont, c);
+   }
+   glClearColor(clearColor[0], clearColor[1], clearColor[2], clearColor[3]);
+   glClear(GL_COLOR_BUFFER_BIT);
+   glDisable(GL_SCISSOR_TEST);
+
+   GLuint name;
+   glGenTextures(1, &name);
+   glBindTexture(GL_TEXTURE_2D, name);
+   glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+   glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+   glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+   glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, ATLAS_WIDTH, ATLAS_HEIGHT, 0,
+                GL_RGBA, GL_UNSIGNED_BYTE, rgba.data());
+   texture = name;
+}
+
+/*************************************************************************
+ * LAYOUT
+ * One quad per glyph, just covering its pixels, four corners
+ * counterclockwise from the bottom left. The pen moves along as GLUT's
+ * would. Blanks take no quad.
+ *************************************************************************/
+void GlyphAtlas :: layout(float x, float y, const char * text, size_t length,
+                          std::vector<GlyphVertex> & quads) const
+{
+   for (size_t i = 0; i < length; i++)
+   {
+      int c = (unsigned char)text[i];
+      if (c < GLYPH_FIRST || c > GLYPH_LAST)
+         continue;
+      int index = c - GLYPH_FIRST;
+      const Glyph & glyph = glyphs[index];
+      if (glyph.width > 0)
+      {
+         // in pixels on the screen, then in the atlas
+         float left   = x + glyph.left - GLYPH_ORIGIN;
+         float bottom = y + glyph.bottom - GLYPH_ORIGIN;
+         float right  = left + glyph.width;
+         float top    = bottom + glyph.height;
+         float u0 = (float)((index % GLYPH_COLUMNS) * GLYPH_CELL + glyph.left) / ATLAS_WIDTH;
+         float v0 = (float)((index / GLYPH_COLUMNS) * GLYPH_CELL + glyph.bottom) / ATLAS_HEIGHT;
+         float u1 = u0 + (float)glyph.width / ATLAS_WIDTH;
+         float v1 = v0 + (float)glyph.height / ATLAS_HEIGHT;
+         quads.push_back({ left,  bottom, u0, v0 });
+         quads.push_back({ right, bottom, u1, v0 });
+         quads.push_back({ right, top,    u1, v1 });
+         quads.push_back({ left,  top,    u0, v1 });
+      }
+      x += glyph.advance;
+   }
+}
+
+/*************************************************************************
+ * DRAW
+ * White text, blended by the coverage in the atlas
+ *************************************************************************/
+void GlyphAtlas :: draw(const std::vector<GlyphVertex> & quads) const
+{
+   if (quads.empty())
+      return;
+
+   glBindTexture(GL_TEXTURE_2D, texture);
+   glEnable(GL_TEXTURE_2D);
+   glEnable(GL_BLEND);
+   glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+   glColor4f(1.0f, 1.0f, 1.0f, 1.0f);
+
+   glEnableClientState(GL_VERTEX_ARRAY);
+   glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+   glVertexPointer(2, GL_FLOAT, sizeof(GlyphVertex), &quads[0].x);
+   glTexCoordPointer(2, GL_FLOAT, sizeof(GlyphVertex), &quads[0].u);
+   glDrawArrays(GL_QUADS, 0, (GLsizei)quads.size());
+   glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+   glDisableClientState(GL_VERTEX_ARRAY);
+
+   glDisable(GL_BLEND);
+   glDisable(GL_TEXTURE_2D);
+}
@@ -0,0 +1,79 @@
+/***********************************************************************
+ * Header File:
+ *    Glyph Atlas : A bitmap font rasterized once into a texture
+ * Author:
+ *    Emilio Regino, Bradley Payne, Penelope Sanchez
+ * Summary:
+ *    Drawing text a character at a time with glutBitmapCharacter costs
+ *    a call per glyph every frame. Instead each printable character is
+ *    drawn once, read back, and packed into one texture. A line of text
+ *    is then a row of textured quads, and every line of a frame goes to
+ *    the card in one call.
+ ************************************************************************/
+
+#pragma once
+
+#include <vector>      // for VECTOR
+#include <cstddef>     // for SIZE_T
+
+// the characters in the atlas; the rest are not drawn
+const int GLYPH_FIRST = 32;
+const int GLYPH_LAST = 126;
+
+// each glyph gets a square cell, with its origin this far in from the
+// cell's bottom left so the parts below the baseline fit too
+const int GLYPH_CELL = 20;
+const int GLYPH_ORIGIN = 5;
+const int GLYPH_COLUMNS = 16;
+
+/************************************************************
+ * GLYPH VERTEX
+ * One corner of a glyph's quad: where it goes, in pixels from
+ * the center of the screen, and where it is in the atlas
+ ************************************************************/
+struct GlyphVertex
+{
+   float x;
+   float y;
+   float u;
+   float v;
+};
+
+/************************************************************
+ * GLYPH ATLAS
+ * A GLUT bitmap font as one texture, white with the coverage
+ * in the alpha
+ ************************************************************/
+class GlyphAtlas
+{
+public:
+   GlyphAtlas(void * pFont) : pFont(pFont), texture(0), glyphs() {}
+
+   // rasterize the font. Needs the window's GL context, and draws in
+   // its bottom left corner, clearing it again afterward.
+   void build();
+   bool isBuilt() const { return texture != 0; }
+
+   // add the quads for one line of text, starting at its baseline
+   void layout(float x, float y, const char * text, size_t length,
+               std::vector<GlyphVertex> & quads) const;
+
+   // draw quads from layout(), all in one call
+   void draw(const std::vector<GlyphVertex> & quads) const;
+
+private:
+   // where a glyph's pixels are in its cell, so its quad covers only
+   // them, and how far it moves the pen
+   struct Glyph
+   {
+      int left;      // first column with anything in it
+      int bottom;    // first row
+      int width;     // 0 for a blank
+      int height;
+      int advance;
+   };
+
+   void * pFont;                                  // which GLUT font
+   unsigned int texture;                          // 0 until built
+   Glyph glyphs[GLYPH_LAST - GLYPH_FIRST + 1];
+};
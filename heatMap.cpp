@@ -0,0 +1,142 @@
+/***********************************************************************
+ * Source File:
+ *    Heat Map : How crowded each pixel of the sky is
+ * Author:
+ *    Emilio Regino, Bradley Payne, Penelope Sanchez
+ * Summary:
+ *    The satellites are split among the workers, which add into one
+ *    shared grid of atomic counts; the order they add in cannot change
+ *    the totals. With one worker the adds need not be locked. The tone
+ *    map then takes the counts a slice of rows per worker: once to find
+ *    the largest, and again to scale each against it on a log scale and
+ *    clear it for the next frame.
+ ************************************************************************/
+
+#include "heatMap.h"    // for HEAT MAP
+#include "parallel.h"   // for PARALLEL FOR
+#include "uiDraw.h"     // for DRAW HEAT MAP
+#include "position.h"   // for POSITION
+#include <algorithm>    // for MAX
+#include <cmath>        // for FLOOR, LOG
+#include <cassert>      // for ASSERT
+
+// fewest satellites, or rows, worth handing to another thread
+const size_t SATELLITE_GRAIN = 4096;
+const size_t ROW_GRAIN = 64;
+
+/**********************************************************************
+ * CONSTRUCTOR
+ * The grid itself waits until there is something to count
+ **********************************************************************/
+HeatMap :: HeatMap(int width, int height, int workers) :
+   width(width), height(height), workers(workers < 1 ? 1 : workers)
+{
+   assert(width > 0 && height > 0);
+   most.resize(this->workers);
+   landed.resize(this->workers);
+}
+
+/**********************************************************************
+ * SPLAT
+ * Add one to the pixel under every satellite but the ship
+ **********************************************************************/
+size_t HeatMap :: splat(const std::vector<SatelliteState> & satellites, double fraction)
+{
+   if (!counts)
+   {
+      counts.reset(new std::atomic<uint32_t>[(size_t)width * height]);
+      for (size_t i = 0; i < (size_t)width * height; i++)
+         counts[i].store(0, std::memory_order_relaxed);
+      levels.resize((size_t)width * height);
+   }
+
+   // the zoom is the same for everyone: one divide, not one each
+   double pixelsFromMeters = 1.0 / Position().getZoom();
+   double centerX = width / 2.0;
+   double centerY = height / 2.0;
+
+   // a locked add costs a third again as much; alone, we do not need it
+   bool shared = workers > 1 && satellites.size() >= 2 * SATELLITE_GRAIN;
+
+   std::fill(landed.begin(), landed.end(), 0);
+   parallelFor(satellites.size(), workers, SATELLITE_GRAIN,
+               [&](int worker, size_t begin, size_t end)
+   {
+      size_t num = 0;
+      for (size_t i = begin; i < end; i++)
+      {
+         const SatelliteState & state = satellites[i];
+         if (state.kind == KIND_SHIP)
+            continue;
+
+         double x = state.lastX + (state.x - state.lastX) * fraction;
+         double y = state.lastY + (state.y - state.lastY) * fraction;
+         double column = floor(centerX + x * pixelsFromMeters);
+         double row    = floor(centerY - y * pixelsFromMeters);
+         if (column < 0.0 || column >= width || row < 0.0 || row >= height)
+            continue;
+
+         std::atomic<uint32_t> & count = counts[(size_t)row * width + (size_t)column];
+         if (shared)
+            count.fetch_add(1, std::memory_order_relaxed);
+         else
+            count.store(count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+         num++;
+      }
+      landed[worker] = num;
+   });
+
+   size_t total = 0;
+   for (size_t num : landed)
+      total += num;
+   return total;
+}
+
+/**********************************************************************
+ * TONE MAP
+ * Each count as a level from 1 to 255 by its log against the largest,
+ * so a lone fragment still shows beside a pile of thousands. Empty
+ * pixels are 0. The counts are cleared on the way.
+ **********************************************************************/
+void HeatMap :: toneMap()
+{
+   std::fill(most.begin(), most.end(), 0);
+   parallelFor((size_t)height, workers, ROW_GRAIN,
+               [this](int worker, size_t begin, size_t end)
+   {
+      uint32_t largest = 0;
+      for (size_t i = begin * width; i < end * width; i++)
+         largest = std::max(largest, counts[i].load(std::memory_order_relaxed));
+      most[worker] = largest;
+   });
+   uint32_t largest = *std::max_element(most.begin(), most.end());
+   double scale = (largest > 1) ? 254.0 / log((double)largest) : 0.0;
+
+   parallelFor((size_t)height, workers, ROW_GRAIN,
+               [this, largest, scale](int, size_t begin, size_t end)
+   {
+      for (size_t i = begin * width; i < end * width; i++)
+      {
+         uint32_t count = counts[i].load(std::memory_order_relaxed);
+         if (count == 0)
+         {
+            levels[i] = 0;
+            continue;
+         }
+         counts[i].store(0, std::memory_order_relaxed);
+         levels[i] = (largest == 1) ? 255 :
+                     (unsigned char)(1.0 + log((double)count) * scale + 0.5);
+      }
+   });
+}
+
+/**********************************************************************
+ * DRAW
+ **********************************************************************/
+void HeatMap :: draw()
+{
+   if (!counts)
+      return;
+   toneMap();
+   drawHeatMap(levels.data(), width, height);
+}
@@ -0,0 +1,58 @@
+/***********************************************************************
+ * Header File:
+ *    Heat Map : How crowded each pixel of the sky is
+ * Author:
+ *    Emilio Regino, Bradley Payne, Penelope Sanchez
+ * Summary:
+ *    Past a few tens of thousands of satellites, drawing each one is
+ *    slower than it is useful: they are a pixel or less apiece and pile
+ *    up on each other. Instead every satellite adds one to the pixel it
+ *    falls in, and the counts are turned into one picture, dim where
+ *    the sky is sparse and bright where it is crowded. That costs one
+ *    pass over the satellites and one over the pixels however many
+ *    there are.
+ ************************************************************************/
+
+#pragma once
+
+#include "snapshot.h"   // for SATELLITE STATE
+#include <vector>       // for VECTOR
+#include <atomic>       // for ATOMIC
+#include <memory>       // for UNIQUE_PTR
+#include <cstdint>      // for UINT32_T
+
+class TestHeatMap;
+
+/************************************************************
+ * HEAT MAP
+ * A count per pixel of the screen, with row 0 at the top and
+ * the center of the grid at the center of the screen
+ ************************************************************/
+class HeatMap
+{
+public:
+   friend TestHeatMap;
+
+   HeatMap(int width, int height, int workers);
+
+   // count every satellite but the ship into its pixel, a fraction of
+   // the way through its last step. Returns how many landed on the grid.
+   size_t splat(const std::vector<SatelliteState> & satellites, double fraction);
+
+   // turn the counts into brightness, draw it, and start the counts over
+   void draw();
+
+   int getWidth()  const { return width;  }
+   int getHeight() const { return height; }
+
+private:
+   void toneMap();
+
+   int width;
+   int height;
+   int workers;                                    // most threads to use
+   std::unique_ptr<std::atomic<uint32_t>[]> counts; // set aside on first use
+   std::vector<unsigned char> levels;              // 0 empty, 255 the most crowded
+   std::vector<uint32_t> most;                     // each worker's highest count
+   std::vector<size_t> landed;                     // each worker's satellites on the grid
+};
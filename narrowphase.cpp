@@ -0,0 +1,97 @@
+/***********************************************************************
+ * Source File:
+ *    Narrowphase : The exact circle-against-circle collision test
+ * Author:
+ *    Emilio Regino, Bradley Payne, Penelope Sanchez
+ * Summary:
+ *    Gathers candidate pairs into lanes and tests them with squared
+ *    distance compares, a group of LANES pairs at a time.
+ ************************************************************************/
+
+#include "narrowphase.h"   // for TEST PAIRS
+
+#if defined(__AVX__) || defined(__SSE2__)
+#include <immintrin.h>     // for _MM256_* and _MM_*
+#endif
+
+/**********************************************************************
+ * OVERLAP
+ * Is (x1 - x2)^2 + (y1 - y2)^2 < (r1 + r2)^2 for one pair
+ **********************************************************************/
+static inline bool overlap(const double * xs, const double * ys, const double * radii,
+                           const CandidatePair & pair)
+{
+   double dx = xs[pair.index1] - xs[pair.index2];
+   double dy = ys[pair.index1] - ys[pair.index2];
+   double reach = radii[pair.index1] + radii[pair.index2];
+   return dx * dx + dy * dy < reach * reach;
+}
+
+/**********************************************************************
+ * OVERLAP LANES
+ * The same test on LANES pairs at once: bit i of the mask is set when
+ * pairs[i] overlaps. The values go straight from the snapshot into
+ * registers, never through memory, so nothing stalls waiting on a store.
+ **********************************************************************/
+static inline int overlapLanes(const double * xs, const double * ys, const double * radii,
+                               const CandidatePair * pairs)
+{
+#if defined(__AVX__)
+   unsigned int a0 = pairs[0].index1, a1 = pairs[1].index1, a2 = pairs[2].index1, a3 = pairs[3].index1;
+   unsigned int b0 = pairs[0].index2, b1 = pairs[1].index2, b2 = pairs[2].index2, b3 = pairs[3].index2;
+   __m256d dx    = _mm256_sub_pd(_mm256_set_pd(xs[a3], xs[a2], xs[a1], xs[a0]),
+                                 _mm256_set_pd(xs[b3], xs[b2], xs[b1], xs[b0]));
+   __m256d dy    = _mm256_sub_pd(_mm256_set_pd(ys[a3], ys[a2], ys[a1], ys[a0]),
+                                 _mm256_set_pd(ys[b3], ys[b2], ys[b1], ys[b0]));
+   __m256d reach = _mm256_add_pd(_mm256_set_pd(radii[a3], radii[a2], radii[a1], radii[a0]),
+                                 _mm256_set_pd(radii[b3], radii[b2], radii[b1], radii[b0]));
+   __m256d d2    = _mm256_add_pd(_mm256_mul_pd(dx, dx), _mm256_mul_pd(dy, dy));
+   return _mm256_movemask_pd(_mm256_cmp_pd(d2, _mm256_mul_pd(reach, reach), _CMP_LT_OQ));
+#elif defined(__SSE2__)
+   int mask = 0;
+   for (int half = 0; half < LANES; half += 2)
+   {
+      unsigned int a0 = pairs[half].index1, a1 = pairs[half + 1].index1;
+      unsigned int b0 = pairs[half].index2, b1 = pairs[half + 1].index2;
+      __m128d dx    = _mm_sub_pd(_mm_set_pd(xs[a1], xs[a0]), _mm_set_pd(xs[b1], xs[b0]));
+      __m128d dy    = _mm_sub_pd(_mm_set_pd(ys[a1], ys[a0]), _mm_set_pd(ys[b1], ys[b0]));
+      __m128d reach = _mm_add_pd(_mm_set_pd(radii[a1], radii[a0]),
+                                 _mm_set_pd(radii[b1], radii[b0]));
+      __m128d d2    = _mm_add_pd(_mm_mul_pd(dx, dx), _mm_mul_pd(dy, dy));
+      mask |= _mm_movemask_pd(_mm_cmplt_pd(d2, _mm_mul_pd(reach, reach))) << half;
+   }
+   return mask;
+#else
+   int mask = 0;
+   for (int i = 0; i < LANES; i++)
+      mask |= (int)overlap(xs, ys, radii, pairs[i]) << i;
+   return mask;
+#endif
+}
+
+/**********************************************************************
+ * TEST PAIRS
+ * Whole groups of LANES pairs go through the lanes, and whatever is
+ * left over at the end is tested one at a time.
+ **********************************************************************/
+size_t testPairs(const double * xs, const double * ys, const double * radii,
+                 const CandidatePair * pairs, size_t count, unsigned char * hits)
+{
+   size_t numHits = 0;
+   size_t k = 0;
+   for (; k + LANES <= count; k += LANES)
+   {
+      int mask = overlapLanes(xs, ys, radii, pairs + k);
+      for (int i = 0; i < LANES; i++)
+      {
+         hits[k + i] = (mask >> i) & 1;
+         numHits += hits[k + i];
+      }
+   }
+   for (; k < count; k++)
+   {
+      hits[k] = overlap(xs, ys, radii, pairs[k]);
+      numHits += hits[k];
+   }
+   return numHits;
+}
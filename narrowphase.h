@@ -0,0 +1,39 @@
+/***********************************************************************
+ * Header File:
+ *    Narrowphase : The exact circle-against-circle collision test
+ * Author:
+ *    Emilio Regino, Bradley Payne, Penelope Sanchez
+ * Summary:
+ *    Tests candidate pairs several at a time. Positions and radii of
+ *    each group of pairs are gathered into lanes and compared as squared
+ *    distances, so there is never a square root. Built with AVX the
+ *    four lanes are one instruction each; with SSE2 they are two; with
+ *    neither they are a plain loop.
+ ************************************************************************/
+
+#pragma once
+
+#include <cstddef>     // for SIZE_T
+
+// how many pairs are tested at once
+const int LANES = 4;
+
+/**********************************************************************
+ * CANDIDATE PAIR
+ * Two satellites close enough to be worth an exact test, by their index
+ * in this frame's snapshot
+ **********************************************************************/
+struct CandidatePair
+{
+   unsigned int index1;
+   unsigned int index2;
+};
+
+/**********************************************************************
+ * TEST PAIRS
+ * Test a run of candidate pairs against a snapshot of positions and
+ * radii, setting hits[k] to 1 when the two circles of pairs[k] overlap
+ * and 0 when they do not. Returns how many hit.
+ **********************************************************************/
+size_t testPairs(const double * xs, const double * ys, const double * radii,
+                 const CandidatePair * pairs, size_t count, unsigned char * hits);
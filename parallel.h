@@ -0,0 +1,61 @@
+/***********************************************************************
+ * Header File:
+ *    Parallel : Splitting a loop across threads
+ * Author:
+ *    Emilio Regino, Bradley Payne, Penelope Sanchez
+ * Summary:
+ *    A minimal fork/join helper. The work is cut into one contiguous
+ *    slice per worker so which worker gets which items never depends on
+ *    timing, only on the worker count.
+ ************************************************************************/
+
+#pragma once
+
+#include <thread>     // for THREAD
+#include <vector>     // for VECTOR
+#include <cstddef>    // for SIZE_T
+
+/*************************************************************************
+ * NUM WORKERS
+ * How many threads the hardware can run at once
+ *************************************************************************/
+inline int numWorkers()
+{
+   unsigned int num = std::thread::hardware_concurrency();
+   return num ? (int)num : 1;
+}
+
+/*************************************************************************
+ * PARALLEL FOR
+ * Call work(worker, begin, end) on one slice of [0, count) per worker.
+ * Worker 0 runs on the calling thread. No slice is made smaller than
+ * grain, so small loops stay on one thread.
+ *   INPUT  count    How many items there are
+ *          workers  The most threads to use
+ *          grain    The fewest items worth a thread
+ *          work     Called once per slice
+ *   OUTPUT <return> How many slices were made
+ *************************************************************************/
+template <class Work>
+int parallelFor(size_t count, int workers, size_t grain, Work work)
+{
+   if (grain == 0)
+      grain = 1;
+   if ((size_t)workers > count / grain)
+      workers = (int)(count / grain);
+   if (workers <= 1)
+   {
+      work(0, (size_t)0, count);
+      return 1;
+   }
+
+   std::vector<std::thread> threads;
+   threads.reserve(workers - 1);
+   for (int w = 1; w < workers; w++)
+      threads.emplace_back(work, w, count * w / workers, count * (w + 1) / workers);
+   work(0, (size_t)0, count / workers);
+
+   for (auto & thread : threads)
+      thread.join();
+   return workers;
+}
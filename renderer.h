@@ -0,0 +1,125 @@
+/***********************************************************************
+ * Header File:
+ *    Renderer : Where a finished frame goes
+ * Author:
+ *    Emilio Regino, Bradley Payne, Penelope Sanchez
+ * Summary:
+ *    The draw* functions in uiDraw build up a frame of colored points,
+ *    an image, trails, triangles, lines and text. At the end of the
+ *    frame it is handed to a renderer, which may put it on the screen
+ *    with OpenGL, paint it into memory, or throw it away.
+ ************************************************************************/
+
+#pragma once
+
+#include <string>     // for STRING
+#include <vector>     // for VECTOR
+
+/************************************************************
+ * VERTEX
+ * One transformed, colored vertex, in pixels from the center
+ * of the screen with y going up
+ ************************************************************/
+struct Vertex
+{
+   float x;
+   float y;
+   unsigned char rgba[4];
+};
+
+/************************************************************
+ * TEXT
+ * A line of text and where its top left corner goes. The
+ * characters are kept in the frame, every line end to end,
+ * so a frame of text allocates nothing once warmed up.
+ ************************************************************/
+struct Text
+{
+   float x;
+   float y;
+   size_t first;    // where it starts in the frame's characters
+   size_t length;
+};
+
+/************************************************************
+ * IMAGE
+ * A picture drawn pixel for pixel, with row 0 at the top
+ ************************************************************/
+struct Image
+{
+   float x;                          // top left corner, in pixels
+   float y;                          //    from the center, y up
+   int width;                        // 0 when there is no picture
+   int height;
+   std::vector<unsigned char> rgba;  // four bytes per pixel
+};
+
+/************************************************************
+ * SPRITE
+ * A picture cut from the frame's atlas, drawn pixel for pixel
+ * wherever the atlas is not see-through
+ ************************************************************/
+struct Sprite
+{
+   float x;                 // top left corner, in pixels from
+   float y;                 //    the center, y up
+   unsigned short u;        // top left corner in the atlas
+   unsigned short v;
+   unsigned short width;
+   unsigned short height;
+};
+
+/************************************************************
+ * FRAME
+ * Everything drawn in one frame, one array per primitive.
+ * Points are the background, then the image and the trails,
+ * blended over it by their alpha; the filled shapes go on top
+ * of them in order, then the sprites, the lines, and the text.
+ ************************************************************/
+struct Frame
+{
+   std::vector<Vertex> points;
+   Image image = { 0.0f, 0.0f, 0, 0 };   // at most one, such as the heat map
+   std::vector<Vertex> trails;      // every two is a segment, blended
+   std::vector<Vertex> triangles;   // every three is a triangle
+   std::vector<Sprite> sprites;     // from the atlas
+   const Image * pAtlas = NULL;     // set whenever there are sprites
+   unsigned int atlasVersion = 0;   // changes whenever the atlas does
+   std::vector<Vertex> lines;       // every two is a segment
+   std::vector<Text> texts;
+   std::string characters;          // of every text, end to end
+
+   void clear()
+   {
+      points.clear();
+      image.width = image.height = 0;   // keeps its memory
+      trails.clear();
+      triangles.clear();
+      sprites.clear();
+      pAtlas = NULL;
+      lines.clear();
+      texts.clear();
+      characters.clear();
+   }
+};
+
+/************************************************************
+ * RENDERER
+ * Something that can draw a finished frame
+ ************************************************************/
+class Renderer
+{
+public:
+   virtual ~Renderer() {}
+   virtual void render(const Frame & frame) = 0;
+};
+
+/************************************************************
+ * NULL RENDERER
+ * Draws nothing, for running the simulator flat out
+ ************************************************************/
+class NullRenderer : public Renderer
+{
+public:
+   void render(const Frame &) {}
+};
@@ -12,11 +12,17 @@
 #include "satellite.h"     // for SATELLITE
 #include "constants.h"     // for EARTH_RADIUS, ANGULAR_VELOCITY, GRAVITY
 
+// identifier 0 belongs to the earth, so satellites start counting at 1
+unsigned int Satellite :: nextId = EARTH_ID + 1;
+
 /**********************************************************************
  * SATELLITE DEFAULT CONSTRUCTOR
  **********************************************************************/
 Satellite :: Satellite()
 {
+   // every satellite gets its own identifier
+   id = nextId++;
+   
    // position defaults to (0.0, 0.0)
    position.setMeters(0.0, 0.0);
    
@@ -42,6 +48,9 @@ Satellite :: Satellite()
  **********************************************************************/
 Satellite :: Satellite(Position pos, Velocity init, double rad)
 {
+   // every satellite gets its own identifier
+   id = nextId++;
+   
    // set the position
    position.setMeters(pos.getMetersX(), pos.getMetersY());
    
@@ -68,6 +77,9 @@ Satellite :: Satellite(Position pos, Velocity init, double rad)
  **********************************************************************/
 Satellite :: Satellite(const Satellite & parent, Angle shootoff, double rad)
 {
+   // every satellite gets its own identifier
+   id = nextId++;
+   
    // start at parent's position
    position = parent.getPosition();
 
@@ -93,12 +105,39 @@ Satellite :: Satellite(const Satellite & parent, Angle shootoff, double rad)
    radius = rad * position.getZoom();
 }
 
+/**********************************************************************
+ * GET STATE
+ * Everything the display needs to draw this satellite
+ **********************************************************************/
+SatelliteState Satellite :: getState() const
+{
+   SatelliteState state;
+   state.id = id;
+   state.kind = getKind();
+   state.thrust = isThrusting();
+   state.x = position.getMetersX();
+   state.y = position.getMetersY();
+   state.rotation = getRotation();
+   state.radius = radius;
+
+   // something that has not moved yet was always here
+   state.lastX = updated ? lastPosition.getMetersX() : state.x;
+   state.lastY = updated ? lastPosition.getMetersY() : state.y;
+   state.lastRotation = updated ? lastRotation : state.rotation;
+   return state;
+}
+
 /**********************************************************************
  * UPDATE
  * updates a satellite for a specified unit of time
  **********************************************************************/
 void Satellite :: update(double time)
 {
+   // remember where we were, so the display can draw in between
+   lastPosition = position;
+   lastRotation = getRotation();
+   updated = true;
+   
    // the direction of the pull of gravity
    double gravityMagnitude = computeGravity();
    
@@ -629,13 +668,13 @@ void Ship :: destroy(std::list<Satellite *> & satellites) const
  *    Right: rotate right by 0.1 radians
  *    Space: shoot projectile
  **********************************************************************/
-void Ship :: input(const Interface* pUI, std::list<Satellite *> & satellites)
+void Ship :: input(const Controls & controls, std::list<Satellite *> & satellites)
 {
    // left & right input
-   angularVelocity += (pUI->isRight() ? 0.1 : 0.0) + (pUI->isLeft() ? -0.1 : 0.0);
+   angularVelocity += (controls.right ? 0.1 : 0.0) + (controls.left ? -0.1 : 0.0);
    
    // down input
-   if (pUI->isDown())
+   if (controls.down)
    {
       // set thrust to true and apply the additional thrust acceleration
       thrust = true;
@@ -646,7 +685,7 @@ void Ship :: input(const Interface* pUI, std::list<Satellite *> & satellites)
       thrust = false;
 
    // space input
-   if (pUI->isSpace())
+   if (controls.space)
    {
       // create the bullet velocity
       Velocity vBullet (angle, 9000.0);
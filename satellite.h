@@ -14,7 +14,8 @@
 #include "angle.h"         // for SATELLITE
 #include "velocity.h"      // for VELOCITY
 #include "uiDraw.h"        // for DRAW *
-#include "uiInteract.h"    // for INTERFACE
+#include "controls.h"      // for CONTROLS
+#include "snapshot.h"      // for SATELLITE STATE
 #include "constants.h"     // for CONSTANTS
 #include <list>            // for LIST
 
@@ -38,7 +39,11 @@ public:
    // the satellite parent constructor
    Satellite(const Satellite & parent, Angle shootoff, double rad);
    
+   // the simulator deletes satellites through base pointers
+   virtual ~Satellite() {}
+   
    // accessors
+   unsigned int getId()    const { return id;         }
    Position getPosition()  const { return position;   }
    Velocity getVelocity()  const { return velocity;   }
    double getAngle() const { return angle.getDegrees(); }
@@ -52,13 +57,22 @@ public:
    virtual void age(double amountSeconds) { /* Only atomic satellites age */}
    
    // input & output
-   virtual void draw() const = 0;
+   virtual Kind getKind() const = 0;
+   SatelliteState getState() const;
+   void draw() const { drawSatellite(getState()); }
    virtual void destroy(std::list<Satellite *> & satellites) const = 0;
-   virtual void input(const Interface* pUI, std::list<Satellite *> & satellites)
+   virtual void input(const Controls & controls, std::list<Satellite *> & satellites)
    { /* all satellites ignore input except for ship */ }
    
 protected:
+   // which way the drawing is turned, and whether it has a flame
+   virtual double getRotation() const { return angularVelocity; }
+   virtual bool isThrusting()   const { return false; }
+
    Position position;               // the position of the satellite
+   Position lastPosition;           // and where it was before the last update
+   double lastRotation = 0.0;       // how its drawing was turned then
+   bool updated = false;            // has it been updated at all yet?
    Angle angle;                     // the angle of the satellite
    Velocity velocity;               // the velocity of the satellite
    double angularVelocity;          // the speed of rotation of the satellite in radian
@@ -66,6 +80,10 @@ protected:
    double radius;                   // the radius of the satellite in pixels
    
 private:
+   unsigned int id;                 // unique, never reused, identifier
+   static unsigned int nextId;      // the identifier the next satellite gets
+   
+
    double computeGravity() const;
    double computeAltitude() const;
    bool closeEnough(double computedValue, double hardcodeValue) const;
@@ -85,7 +103,7 @@ public:
    void destroy(std::list<Satellite *> & satellites) const;
    
    // Must reimplement for sputnik specific draw
-   void draw() const { drawSputnik(position, angularVelocity); }
+   Kind getKind() const { return KIND_SPUTNIK; }
 };
 
 /**********************************************************************
@@ -102,7 +120,7 @@ public:
    void destroy(std::list<Satellite *> & satellites) const;
    
    // Must reimplement for GPS specific
-   void draw() const { drawGPS(position, angularVelocity); }
+   Kind getKind() const { return KIND_GPS; }
 };
 
 /**********************************************************************
@@ -119,7 +137,7 @@ public:
    void destroy(std::list<Satellite *> & satellites) const;
    
    // Must reimplement for GPS Center specific draw
-   void draw() const { drawGPSCenter(position, angularVelocity); }
+   Kind getKind() const { return KIND_GPS_CENTER; }
 };
 
 /**********************************************************************
@@ -136,7 +154,7 @@ public:
    void destroy(std::list<Satellite *> & satellites) const;
    
    // Must reimplement for GPS Right specific draw
-   void draw() const { drawGPSRight(position, angularVelocity, Position()); }
+   Kind getKind() const { return KIND_GPS_RIGHT; }
 };
 
 /**********************************************************************
@@ -153,7 +171,7 @@ public:
    void destroy(std::list<Satellite *> & satellites) const;
    
    // Must reimplement for GPS Left specific draw
-   void draw() const { drawGPSRight(position, angularVelocity, Position()); }
+   Kind getKind() const { return KIND_GPS_LEFT; }
 };
 
 /**********************************************************************
@@ -170,7 +188,7 @@ public:
    void destroy(std::list<Satellite *> & satellites) const;
    
    // Must reimplement for hubble specific draw
-   void draw() const { drawHubble(position, angularVelocity); }
+   Kind getKind() const { return KIND_HUBBLE; }
 };
 
 /**********************************************************************
@@ -187,7 +205,7 @@ public:
    void destroy(std::list<Satellite *> & satellites) const;
    
    // Must reimplement for hubble telescope specific draw
-   void draw() const { drawHubbleTelescope(position, angularVelocity); }
+   Kind getKind() const { return KIND_HUBBLE_TELESCOPE; }
 };
 
 /**********************************************************************
@@ -204,7 +222,7 @@ public:
    virtual void destroy(std::list<Satellite *> & satellites) const;
    
    // Must reimplement for hubble computer specific draw
-   void draw() const { drawHubbleComputer(position, angularVelocity); }
+   Kind getKind() const { return KIND_HUBBLE_COMPUTER; }
 };
 
 /**********************************************************************
@@ -221,7 +239,7 @@ public:
    virtual void destroy(std::list<Satellite *> & satellites) const;
    
    // Must reimplement for hubble left specific draw
-   void draw() const { drawHubbleLeft(position, angularVelocity); }
+   Kind getKind() const { return KIND_HUBBLE_LEFT; }
 };
 
 /**********************************************************************
@@ -238,7 +256,7 @@ public:
    virtual void destroy(std::list<Satellite *> & satellites) const;
    
    // Must reimplement for hubble right specific draw
-   void draw() const { drawHubbleRight(position, angularVelocity); }
+   Kind getKind() const { return KIND_HUBBLE_RIGHT; }
 };
 
 /**********************************************************************
@@ -255,7 +273,7 @@ public:
    void destroy(std::list<Satellite *> & satellites) const;
    
    // Must reimplement for dragon specific draw
-   void draw() const { drawCrewDragon(position, angularVelocity); }
+   Kind getKind() const { return KIND_DRAGON; }
 };
 
 /**********************************************************************
@@ -272,7 +290,7 @@ public:
    virtual void destroy(std::list<Satellite *> & satellites) const;
    
    // Must reimplement for dragon center specific draw
-   void draw() const { drawCrewDragonCenter(position, angularVelocity); }
+   Kind getKind() const { return KIND_DRAGON_CENTER; }
 };
 
 /**********************************************************************
@@ -289,7 +307,7 @@ public:
    virtual void destroy(std::list<Satellite *> & satellites) const;
    
    // Must reimplement for dragon right specific draw
-   void draw() const { drawCrewDragonRight(position, angularVelocity); }
+   Kind getKind() const { return KIND_DRAGON_RIGHT; }
 };
 
 /**********************************************************************
@@ -306,7 +324,7 @@ public:
    virtual void destroy(std::list<Satellite *> & satellites) const;
    
    // Must reimplement for dragon left specific draw
-   void draw() const { drawCrewDragonLeft(position, angularVelocity); }
+   Kind getKind() const { return KIND_DRAGON_LEFT; }
 };
 
 /**********************************************************************
@@ -323,7 +341,7 @@ public:
    void destroy(std::list<Satellite *> & satellites) const;
    
    // Must reimplement for starlink specific draw
-   void draw() const { drawStarlink(position, angularVelocity); }
+   Kind getKind() const { return KIND_STARLINK; }
 };
 
 /**********************************************************************
@@ -340,7 +358,7 @@ public:
    void destroy(std::list<Satellite *> & satellites) const;
    
    // Must reimplement for starlink body specific draw
-   void draw() const { drawStarlinkBody(position, angularVelocity); }
+   Kind getKind() const { return KIND_STARLINK_BODY; }
 };
 
 /**********************************************************************
@@ -357,7 +375,7 @@ public:
    void destroy(std::list<Satellite *> & satellites) const;
    
    // Must reimplement for starlink array specific draw
-   void draw() const { drawStarlinkArray(position, angularVelocity); }
+   Kind getKind() const { return KIND_STARLINK_ARRAY; }
 };
 
 /**********************************************************************
@@ -371,14 +389,18 @@ public:
    Ship();
    
    // Must reimplement for ship specific input
-   void input(const Interface* pUI, std::list<Satellite *> & satellites);
+   void input(const Controls & controls, std::list<Satellite *> & satellites);
    
    // Must reimplement for ship specific destroy
    void destroy(std::list<Satellite *> & satellites) const;
    
    // Must reimplement for ship specific draw
-   void draw() const { drawShip(position, angle.getRadian(), thrust); }
+   Kind getKind() const { return KIND_SHIP; }
    
+protected:
+   double getRotation() const { return angle.getRadian(); }
+   bool isThrusting()   const { return thrust; }
+
 private:
    bool thrust;   // is the ship thrusting
 };
@@ -424,7 +446,7 @@ public:
    Fragment(const Satellite & parent, Angle shootOff);
    
    // Must reimplement for fragment specific draw
-   void draw() const { drawFragment(position, angularVelocity); }
+   Kind getKind() const { return KIND_FRAGMENT; }
 };
 
 /**********************************************************************
@@ -438,5 +460,5 @@ public:
    Projectile(const Ship & parent, Velocity bullet);
    
    // Must reimplement for projectile specific draw
-   void draw() const { drawProjectile(position); }
+   Kind getKind() const { return KIND_PROJECTILE; }
 };
@@ -0,0 +1,113 @@
+/***********************************************************************
+ * Source File:
+ *    Simulation Thread : Run the physics apart from the display
+ * Author:
+ *    Emilio Regino, Bradley Payne, Penelope Sanchez
+ * Summary:
+ *    The keys cross from the display as a few atomic bits and the
+ *    snapshots cross back through the triple buffer, so the threads
+ *    never share a lock.
+ ************************************************************************/
+
+#include "simulationThread.h"   // for SIMULATION THREAD
+#include <chrono>               // for STEADY_CLOCK
+#include <algorithm>            // for MAX
+
+// the held keys, one bit each
+const unsigned int CONTROL_UP    = 1;
+const unsigned int CONTROL_DOWN  = 2;
+const unsigned int CONTROL_LEFT  = 4;
+const unsigned int CONTROL_RIGHT = 8;
+
+/**********************************************************************
+ * NOW
+ * Steady clock seconds, for stamping snapshots
+ **********************************************************************/
+static double now()
+{
+   return std::chrono::duration<double>(
+             std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/**********************************************************************
+ * CONSTRUCTOR
+ * Publish where everything starts, so the display has something to
+ * draw before the first step, then start stepping
+ **********************************************************************/
+SimulationThread :: SimulationThread(Simulator & simulator, double rate) :
+   simulator(simulator), rate(rate), held(0), fire(false), running(true), steps(0)
+{
+   simulator.capture(snapshots.back());
+   snapshots.back().published = now();
+   snapshots.publish();
+   thread = std::thread(&SimulationThread::run, this);
+}
+
+/**********************************************************************
+ * DESTRUCTOR
+ * Finish the step under way and stop
+ **********************************************************************/
+SimulationThread :: ~SimulationThread()
+{
+   running.store(false);
+   thread.join();
+}
+
+/**********************************************************************
+ * POST
+ * Held keys are whatever was last posted. A shot is kept until the
+ * simulation gets to it, so one is not lost between two steps.
+ **********************************************************************/
+void SimulationThread :: post(const Controls & controls)
+{
+   held.store((controls.up    ? CONTROL_UP    : 0) |
+              (controls.down  ? CONTROL_DOWN  : 0) |
+              (controls.left  ? CONTROL_LEFT  : 0) |
+              (controls.right ? CONTROL_RIGHT : 0), std::memory_order_relaxed);
+   if (controls.space)
+      fire.store(true, std::memory_order_relaxed);
+}
+
+/**********************************************************************
+ * DRAW
+ **********************************************************************/
+void SimulationThread :: draw()
+{
+   const Snapshot & snapshot = snapshots.latest();
+   double fraction = (now() - snapshot.published) * rate;
+   simulator.draw(snapshot, std::min(std::max(fraction, 0.0), 1.0));
+}
+
+/**********************************************************************
+ * RUN
+ * Step at a fixed rate: take the keys, update, publish, then sleep
+ * until the next step is due. A step that runs long is not made up.
+ **********************************************************************/
+void SimulationThread :: run()
+{
+   using clock = std::chrono::steady_clock;
+   auto period = std::chrono::duration_cast<clock::duration>(
+                    std::chrono::duration<double>(1.0 / rate));
+   auto next = clock::now() + period;
+
+   while (running.load())
+   {
+      unsigned int keys = held.load(std::memory_order_relaxed);
+      Controls controls;
+      controls.up    = (keys & CONTROL_UP)    != 0;
+      controls.down  = (keys & CONTROL_DOWN)  != 0;
+      controls.left  = (keys & CONTROL_LEFT)  != 0;
+      controls.right = (keys & CONTROL_RIGHT) != 0;
+      controls.space = fire.exchange(false, std::memory_order_relaxed);
+
+      simulator.input(controls);
+      simulator.update();
+      simulator.capture(snapshots.back());
+      snapshots.back().published = now();
+      snapshots.publish();
+      steps.fetch_add(1, std::memory_order_relaxed);
+
+      std::this_thread::sleep_until(next);
+      next = std::max(next + period, clock::now());
+   }
+}
@@ -0,0 +1,57 @@
+/***********************************************************************
+ * Header File:
+ *    Simulation Thread : Run the physics apart from the display
+ * Author:
+ *    Emilio Regino, Bradley Payne, Penelope Sanchez
+ * Summary:
+ *    The simulator steps at its own fixed rate on a thread of its own.
+ *    After every step it publishes a snapshot through a triple buffer,
+ *    and the display draws the newest one whenever it gets around to
+ *    it. A slow frame on either side no longer holds up the other.
+ *    When the display runs faster than the physics, it draws everything
+ *    part of the way between the last two steps, by how much of a step
+ *    has gone by since the newest one was published.
+ ************************************************************************/
+
+#pragma once
+
+#include "simulator.h"     // for SIMULATOR
+#include "snapshot.h"      // for SNAPSHOT
+#include "controls.h"      // for CONTROLS
+#include "tripleBuffer.h"  // for TRIPLE BUFFER
+#include "constants.h"     // for FRAME_RATE
+#include <atomic>          // for ATOMIC
+#include <thread>          // for THREAD
+
+/**********************************************************************
+ * SIMULATION THREAD
+ * Owns the thread stepping a simulator. Everything public except the
+ * constructor and destructor is for the display thread.
+ **********************************************************************/
+class SimulationThread
+{
+public:
+   SimulationThread(Simulator & simulator, double rate = FRAME_RATE);
+   ~SimulationThread();
+
+   // the keys, for the simulation to act on at its next step
+   void post(const Controls & controls);
+
+   // draw the newest snapshot, as far into its step as the clock says
+   void draw();
+
+   // how many steps the simulation has taken
+   unsigned long getSteps() const { return steps.load(std::memory_order_relaxed); }
+
+private:
+   void run();
+
+   Simulator & simulator;
+   double rate;                        // steps per second
+   TripleBuffer<Snapshot> snapshots;
+   std::atomic<unsigned int> held;     // keys down, as CONTROL_* bits
+   std::atomic<bool> fire;             // space pressed since the last step
+   std::atomic<bool> running;
+   std::atomic<unsigned long> steps;
+   std::thread thread;
+};
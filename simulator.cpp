@@ -8,20 +8,23 @@
  ************************************************************************/
 
 #include "simulator.h"     // for SIMULATOR
+#include "parallel.h"      // for NUM WORKERS
+#include <cmath>           // for FABS
 
 /***********************************************************************
  * CONSTRUCTOR
  * Initializes all the member variables of the orbital
  * simulator: Stars, Satellites, ptUpperRight
  ************************************************************************/
-Simulator::Simulator(Position ptUpperRight)
+Simulator::Simulator(Position ptUpperRight) :
+   stars(ptUpperRight, NUM_STARS),
+   grid(numWorkers()), kinetic(true), trails(TRAIL_LENGTH, TRAIL_BUDGET),
+   heatMap((int)ceil(ptUpperRight.getPixelsX()),
+           (int)ceil(ptUpperRight.getPixelsY()), numWorkers()),
+   heatMapThreshold(HEAT_MAP_THRESHOLD), time(0.0),
+   viewX(ptUpperRight.getPixelsX() / 2.0), viewY(ptUpperRight.getPixelsY() / 2.0),
+   drawn(0), culled(0), showStats(false)
 {
-   // initialize the stars
-   for (int i = 0; i < NUM_STARS; i++)
-   {
-      stars[i] = Star(ptUpperRight);
-   }
-   
    // initialize all the satellites
    Satellite * ship = new Ship;
    Satellite * sputnik = new Sputnik;
@@ -47,19 +50,32 @@ Simulator::Simulator(Position ptUpperRight)
    satellites.push_back(gps4);
    satellites.push_back(gps5);
    satellites.push_back(gps6);
+   
+   // keep our own count of collisions
+   subscribe(&tally);
+}
+
+/*************************************************************************
+ * DESTRUCTOR
+ * The simulator owns its satellites
+ *************************************************************************/
+Simulator::~Simulator()
+{
+   for (auto satellite: satellites)
+      delete satellite;
 }
 
 /*************************************************************************
  * INPUT
  * Handles all the input of the simulator
  *************************************************************************/
-void Simulator::input(const Interface* pUI)
+void Simulator::input(const Controls & controls)
 {
    // only the ship handles input
    // ship should be the first element
    list<Satellite *>::iterator it;
    for (it = satellites.begin(); it != satellites.end(); it++)
-      (*it)->input(pUI, satellites);
+      (*it)->input(controls, satellites);
 }
 
 /*************************************************************************
@@ -75,57 +91,91 @@ void Simulator::update()
    for (auto satellite: satellites)
       satellite->update(TIME_PER_FRAME);
    
-   // kill satellites that have collided
-   list<Satellite *>::iterator it1;
-   list<Satellite *>::iterator it2;
-   for (it1 = satellites.begin(); it1 != satellites.end(); ++it1)
+   time += TIME_PER_FRAME;
+   
+   // extend the trails to where everything is now
+   if (trails.isEnabled())
+      for (auto satellite: satellites)
+         trails.record(satellite->getId(), satellite->getPosition().getMetersX(),
+                       satellite->getPosition().getMetersY());
+   
+   // certificates pay off while the sky is sparse, the grid once it is
+   // crowded. The gap between the two limits keeps us from flip-flopping
+   if (kinetic && satellites.size() > (size_t)KINETIC_LIMIT)
    {
-      it2 = it1;
-      for (it2++; it2 != satellites.end(); ++it2)
-      {
-         // only check for collisions if not dead and not expired
-         if (!(*it1)->isDead() && !(*it2)->isDead() &&
-             !(*it1)->hasExpired() && !(*it2)->hasExpired())
-         {
-            
-            // better not be checking myself
-            assert(it1 != it2);
-            
-            // check for collision with other satellites
-            double distance = computeDistance((*it1)->getPosition(),(*it2)->getPosition());
-            if (distance < (*it1)->getRadius() + (*it2)->getRadius())
-            {
-               (*it1)->kill();
-               (*it2)->kill();
-            }
-            
-            // check for collision with earth for itr1
-            distance = computeDistance((*it1)->getPosition(), earth.getPosition());
-            if (distance < earth.getRadius())
-               (*it1)->kill();
-            
-            // check for collision with earth for itr2
-            distance = computeDistance((*it1)->getPosition(), earth.getPosition());
-            if (distance < earth.getRadius())
-               (*it2)->kill();
-         }
-      }
+      kinetic = false;
+      collisions.reset();
    }
+   else if (!kinetic && satellites.size() < (size_t)KINETIC_LIMIT / 2)
+      kinetic = true;
    
-   for (it1 = satellites.begin(); it1 != satellites.end(); )
+   // kill satellites that have collided with each other or the earth
+   contacts.clear();
+   if (kinetic)
    {
-      // Remove dead satellites
-      if ((*it1)->isDead())
+      // start watching anything new: parts, fragments, and projectiles
+      for (auto satellite: satellites)
+         if (!satellite->isDead() && !collisions.isTracked(satellite))
+            collisions.insert(satellite, time);
+      collisions.advance(time, contacts);
+   }
+   else
+      grid.detect(satellites, contacts);
+   
+   // record everything that collided, then break it all up at once
+   breakup();
+}
+
+/*************************************************************************
+ * BREAKUP
+ * Consumes the frame's collisions in one batch: each is recorded as an
+ * event, everything involved breaks into parts and fragments, the dead
+ * and expired are cleared out, the new pieces join the population
+ * together, and finally the events go out to the subscribers
+ *************************************************************************/
+void Simulator::breakup()
+{
+   events.clear();
+   for (auto & contact: contacts)
+   {
+      contact.pSatellite1->kill();
+      if (contact.pSatellite2)
+         contact.pSatellite2->kill();
+      events.push_back(recordCollision(contact, time));
+   }
+
+   // a satellite can be in more than one collision but breaks up once
+   list<Satellite *> spawned;
+   broken.clear();
+   for (auto & contact: contacts)
+   {
+      if (broken.insert(contact.pSatellite1->getId()).second)
+         contact.pSatellite1->destroy(spawned);
+      if (contact.pSatellite2 && broken.insert(contact.pSatellite2->getId()).second)
+         contact.pSatellite2->destroy(spawned);
+   }
+   
+   // clear out the dead and the expired
+   list<Satellite *>::iterator it;
+   for (it = satellites.begin(); it != satellites.end(); )
+   {
+      if ((*it)->isDead() || (*it)->hasExpired())
       {
-         (*it1)->destroy(satellites);
-         it1 = satellites.erase(it1);
+         collisions.remove(*it);
+         trails.release((*it)->getId());
+         delete *it;
+         it = satellites.erase(it);
       }
-      // Remove expired satellites
-      else if ((*it1)->hasExpired())
-         it1 = satellites.erase(it1);
       else
-         ++it1;
+         ++it;
    }
+   
+   // the new parts and fragments join all at once
+   satellites.splice(satellites.end(), spawned);
+   
+   // nobody has to go looking for what happened
+   for (auto listener: listeners)
+      listener->notify(events);
 }
 
 /*************************************************************************
@@ -133,16 +183,135 @@ void Simulator::update()
  * Draws all the satellites in the simulator to the screen
  *************************************************************************/
 void Simulator::draw()
+{
+   capture(frame);
+   draw(frame);
+}
+
+/*************************************************************************
+ * CAPTURE
+ * Copy out everything the display needs, so it never has to look at
+ * the satellites themselves
+ *************************************************************************/
+void Simulator::capture(Snapshot & snapshot) const
+{
+   snapshot.satellites.clear();
+   for (auto satellite: satellites)
+      snapshot.satellites.push_back(satellite->getState());
+   trails.copyInto(snapshot.trails);
+   snapshot.earthRotation = earth.getAngle();
+   snapshot.lastEarthRotation = earth.getLastAngle();
+   snapshot.time = time;
+}
+
+/*************************************************************************
+ * DRAW
+ * Draws a snapshot of the simulator to the screen, everything placed
+ * a fraction of the way through its last step. Past the heat map
+ * threshold everything but the ship goes into the heat map instead.
+ * This touches only the snapshot and the things that belong to the
+ * display: the stars, the heat map, and the drawn and culled counts.
+ *************************************************************************/
+void Simulator::draw(const Snapshot & snapshot, double fraction)
 {
    // first draw the stars
-   for (int currentStar = 0; currentStar < NUM_STARS; currentStar++)
-      stars[currentStar].draw();
+   stars.draw();
+
+   // then, in a crowded sky, how crowded it is
+   drawn = 0;
+   culled = 0;
+   size_t num = snapshot.satellites.size();
+   if (num > heatMapThreshold)
+   {
+      drawn = heatMap.splat(snapshot.satellites, fraction);
+      heatMap.draw();
+
+      // that leaves only the ship, which is always first
+      size_t ships = (snapshot.satellites.front().kind == KIND_SHIP) ? 1 : 0;
+      culled = num - ships - drawn;
+      num = ships;
+   }
 
    // then the earth
-   earth.draw();
+   drawEarth(Position(), interpolateRotation(snapshot.lastEarthRotation,
+                                             snapshot.earthRotation, fraction));
 
-   // then the satellites
-   list<Satellite *>::iterator it;
-   for (it = satellites.begin(); it != satellites.end(); it++)
-      (*it)->draw();
+   // then where the satellites have been
+   snapshot.trails.draw(fraction);
+
+   // then the satellites, skipping any entirely off the screen and
+   // drawing the far away ones in less detail
+   Detail detail = DETAIL_FULL;
+   for (size_t i = 0; i < num; i++)
+   {
+      const SatelliteState & captured = snapshot.satellites[i];
+      SatelliteState state = (fraction == 1.0) ? captured : interpolate(captured, fraction);
+      if (isVisible(state))
+      {
+         Detail needed = getDetail(state);
+         if (needed != detail)
+            drawDetail(detail = needed);
+         drawSatellite(state);
+         drawn++;
+      }
+      else
+         culled++;
+   }
+
+   // with what the last frame cost on top, if asked, in the top left
+   // corner of what is on the screen
+   countCulled(culled);
+   if (showStats)
+   {
+      Position topLeft;
+      topLeft.setPixelsX(-viewX + STATS_MARGIN);
+      topLeft.setPixelsY(viewY - STATS_MARGIN);
+      drawStats(topLeft);
+   }
+
+   // and send it all at once
+   drawFlush();
+}
+
+/*************************************************************************
+ * IS VISIBLE
+ * Could any of a satellite land on the screen? Its radius is in meters
+ * but it is drawn in pixels, so the reach is worked out at today's zoom.
+ * ptUpperRight is the size of the whole window, as it is everywhere it
+ * is passed in, so the screen reaches half of it either side.
+ *************************************************************************/
+bool Simulator::isVisible(const SatelliteState & state) const
+{
+   Position position(state.x, state.y);
+   double reach = state.radius / position.getZoom() + DRAW_MARGIN;
+   return fabs(position.getPixelsX()) <= viewX + reach &&
+          fabs(position.getPixelsY()) <= viewY + reach;
+}
+
+/*************************************************************************
+ * GET DETAIL
+ * How much of a satellite is worth drawing, by how big it really is on
+ * the screen at today's zoom. The drawings themselves are always the
+ * same number of pixels across.
+ *************************************************************************/
+Detail Simulator::getDetail(const SatelliteState & state) const
+{
+   double pixels = state.radius / Position().getZoom();
+   if (pixels < DETAIL_POINT_PIXELS)
+      return DETAIL_POINT;
+   if (pixels < DETAIL_SIMPLE_PIXELS)
+      return DETAIL_SIMPLE;
+   return DETAIL_FULL;
+}
+
+/*************************************************************************
+ * SCREEN CONJUNCTIONS
+ * Predicts every pair of live satellites that will pass within a
+ * threshold distance (meters) of each other over the next horizon
+ * (seconds), soonest first
+ *************************************************************************/
+vector<Conjunction> Simulator::screenConjunctions(double horizon, double threshold) const
+{
+   ConjunctionScreener screener(horizon, threshold);
+   return screener.screen(satellites);
 }
@@ -13,10 +13,20 @@
 #include "uiDraw.h"     // for RANDOM and DRAW*
 #include "position.h"   // for POINT
 #include "earth.h"      // for EARTH
-#include "star.h"       // for STAR
+#include "star.h"       // for STAR FIELD
 #include "satellite.h"  // for SATELLITE *
 #include "constants.h"  // for CONSTANTS *
+#include "collisionScheduler.h" // for COLLISION SCHEDULER
+#include "conjunction.h"  // for CONJUNCTION SCREENER
+#include "collisionGrid.h" // for COLLISION GRID
+#include "collisionEvent.h" // for COLLISION EVENT
+#include "snapshot.h"   // for SNAPSHOT
+#include "trail.h"      // for TRAILS
+#include "heatMap.h"    // for HEAT MAP
+#include "controls.h"   // for CONTROLS
 #include <list>         // for LIST
+#include <vector>       // for VECTOR
+#include <unordered_set> // for UNORDERED_SET
 
 using namespace std;
 
@@ -27,15 +37,74 @@ using namespace std;
 class Simulator
 {
 public:
+   // test class is a friend for private access
+   friend class TestCollisionEvent;
+
+   // ptUpperRight is how many pixels wide and tall the window is
    Simulator(Position ptUpperRight);
+   ~Simulator();
+
+   // it owns its satellites, so a copy would delete them twice
+   Simulator(const Simulator & rhs) = delete;
+   Simulator & operator = (const Simulator & rhs) = delete;
    
    // handle simulator input, updates, and graphics
-   void input(const Interface* pUI);
+   void input(const Interface* pUI) { input(Controls(pUI)); }
+   void input(const Controls & controls);
    void update();
    void draw();
    
+   // the same split in two, for drawing on another thread: capture() on
+   // the thread that updates, draw(snapshot) on the one that draws. The
+   // fraction is how far through the last step to draw everything.
+   void capture(Snapshot & snapshot) const;
+   void draw(const Snapshot & snapshot, double fraction = 1.0);
+   
+   // hear about every frame's collisions
+   void subscribe(CollisionListener * pListener) { listeners.push_back(pListener); }
+   const CollisionTally & getTally() const { return tally; }
+   
+   // how long the orbit trails are and how many satellites get one;
+   // either one 0 turns them off
+   void setTrails(size_t length, size_t budget) { trails.resize(length, budget); }
+   
+   // past how many satellites they are drawn as a heat map instead
+   void setHeatMapThreshold(size_t threshold) { heatMapThreshold = threshold; }
+   
+   // how many satellites the last frame drew, and how many were off screen
+   size_t getDrawn()  const { return drawn;  }
+   size_t getCulled() const { return culled; }
+   
+   // show what the last frame cost in the top left corner
+   void setShowStats(bool show) { showStats = show; }
+   
+   // predict close approaches among the live satellites
+   vector<Conjunction> screenConjunctions(double horizon, double threshold) const;
+   
 private:
+   void breakup();
+   bool isVisible(const SatelliteState & state) const;
+   Detail getDetail(const SatelliteState & state) const;
+   
    Earth earth;                     // the earth
    list<Satellite *> satellites;    // collection of satellites in orbit
-   Star stars[NUM_STARS];           // the star array
+   StarField stars;                 // the star field
+   CollisionScheduler collisions;   // when each pair next needs a look
+   CollisionGrid grid;              // every pair at once, for crowded skies
+   bool kinetic;                    // are we using collisions or grid?
+   vector<Contact> contacts;        // this frame's collisions
+   vector<CollisionEvent> events;   // and their records, in the same order
+   vector<CollisionListener *> listeners; // who hears about the events
+   CollisionTally tally;            // running count of collisions
+   unordered_set<unsigned int> broken; // ids already broken up this frame
+   Trails trails;                   // where everything has been lately
+   HeatMap heatMap;                 // how crowded the sky is, when it is
+   size_t heatMapThreshold;         // most satellites drawn one by one
+   double time;                     // simulator seconds since the start
+   double viewX;                    // the screen reaches this many pixels
+   double viewY;                    //    either side of the center
+   size_t drawn;                    // satellites drawn in the last frame
+   size_t culled;                   // and skipped as off the screen
+   bool showStats;                  // draw the render stats over it all
+   Snapshot frame;                  // what draw() captures and draws
 };
@@ -0,0 +1,68 @@
+/***********************************************************************
+ * Source File:
+ *    Snapshot : What the display needs to know about one frame
+ * Author:
+ *    Emilio Regino, Bradley Payne, Penelope Sanchez
+ * Summary:
+ *    Turning a satellite's state back into draw calls, from anywhere
+ *    along its last step
+ ************************************************************************/
+
+#include "snapshot.h"   // for SATELLITE STATE
+#include "uiDraw.h"     // for DRAW*
+#include "position.h"   // for POSITION
+#include <cmath>        // for REMAINDER
+
+/************************************************************************
+ * INTERPOLATE ROTATION
+ *************************************************************************/
+double interpolateRotation(double last, double rotation, double fraction)
+{
+   return last + remainder(rotation - last, 2.0 * M_PI) * fraction;
+}
+
+/************************************************************************
+ * INTERPOLATE
+ *************************************************************************/
+SatelliteState interpolate(const SatelliteState & state, double fraction)
+{
+   SatelliteState between = state;
+   between.x = state.lastX + (state.x - state.lastX) * fraction;
+   between.y = state.lastY + (state.y - state.lastY) * fraction;
+   between.rotation = interpolateRotation(state.lastRotation, state.rotation, fraction);
+   return between;
+}
+
+/************************************************************************
+ * DRAW SATELLITE
+ * Draw one satellite from its state. The broken-off pieces are drawn
+ * around their own center, without the offset they had when attached.
+ *************************************************************************/
+void drawSatellite(const SatelliteState & state)
+{
+   Position center(state.x, state.y);
+   double rotation = state.rotation;
+   switch (state.kind)
+   {
+      case KIND_SPUTNIK:          drawSputnik(center, rotation);          break;
+      case KIND_GPS:              drawGPS(center, rotation);              break;
+      case KIND_GPS_CENTER:       drawGPSCenter(center, rotation);        break;
+      case KIND_GPS_RIGHT:        drawGPSRight(center, rotation);         break;
+      case KIND_GPS_LEFT:         drawGPSLeft(center, rotation);          break;
+      case KIND_HUBBLE:           drawHubble(center, rotation);           break;
+      case KIND_HUBBLE_TELESCOPE: drawHubbleTelescope(center, rotation);  break;
+      case KIND_HUBBLE_COMPUTER:  drawHubbleComputer(center, rotation);   break;
+      case KIND_HUBBLE_LEFT:      drawHubbleLeft(center, rotation);       break;
+      case KIND_HUBBLE_RIGHT:     drawHubbleRight(center, rotation);      break;
+      case KIND_DRAGON:           drawCrewDragon(center, rotation);       break;
+      case KIND_DRAGON_CENTER:    drawCrewDragonCenter(center, rotation); break;
+      case KIND_DRAGON_RIGHT:     drawCrewDragonRight(center, rotation);  break;
+      case KIND_DRAGON_LEFT:      drawCrewDragonLeft(center, rotation);   break;
+      case KIND_STARLINK:         drawStarlink(center, rotation);         break;
+      case KIND_STARLINK_BODY:    drawStarlinkBody(center, rotation);     break;
+      case KIND_STARLINK_ARRAY:   drawStarlinkArray(center, rotation);    break;
+      case KIND_SHIP:             drawShip(center, rotation, state.thrust); break;
+      case KIND_FRAGMENT:         drawFragment(center, rotation);         break;
+      case KIND_PROJECTILE:       drawProjectile(center);                 break;
+   }
+}
@@ -0,0 +1,93 @@
+/***********************************************************************
+ * Header File:
+ *    Snapshot : What the display needs to know about one frame
+ * Author:
+ *    Emilio Regino, Bradley Payne, Penelope Sanchez
+ * Summary:
+ *    A copy of the simulation's render-relevant state: where each
+ *    satellite is, which way it is turned, what kind it is, and whether
+ *    the ship is thrusting, now and one step ago, and their trails. The
+ *    simulation fills one in after every step; the display draws from
+ *    it without looking at the satellites, so the two can run on
+ *    different threads, and can draw in between the two steps when it
+ *    runs faster than the physics.
+ ************************************************************************/
+
+#pragma once
+
+#include "trail.h"    // for TRAILS
+#include <vector>      // for VECTOR
+
+/************************************************************
+ * KIND
+ * Which drawing a satellite gets
+ ************************************************************/
+enum Kind : unsigned char
+{
+   KIND_SPUTNIK,
+   KIND_GPS,
+   KIND_GPS_CENTER,
+   KIND_GPS_RIGHT,
+   KIND_GPS_LEFT,
+   KIND_HUBBLE,
+   KIND_HUBBLE_TELESCOPE,
+   KIND_HUBBLE_COMPUTER,
+   KIND_HUBBLE_LEFT,
+   KIND_HUBBLE_RIGHT,
+   KIND_DRAGON,
+   KIND_DRAGON_CENTER,
+   KIND_DRAGON_RIGHT,
+   KIND_DRAGON_LEFT,
+   KIND_STARLINK,
+   KIND_STARLINK_BODY,
+   KIND_STARLINK_ARRAY,
+   KIND_SHIP,
+   KIND_FRAGMENT,
+   KIND_PROJECTILE
+};
+
+/************************************************************
+ * SATELLITE STATE
+ * One satellite as the display sees it
+ ************************************************************/
+struct SatelliteState
+{
+   unsigned int id;
+   Kind kind;
+   bool thrust;          // only the ship ever thrusts
+   double x;             // meters from the center of the earth
+   double y;
+   double rotation;      // radians
+   double radius;        // meters
+   double lastX;         // and where it was one step before
+   double lastY;
+   double lastRotation;
+};
+
+/************************************************************
+ * SNAPSHOT
+ * Everything the display needs for one frame
+ ************************************************************/
+struct Snapshot
+{
+   std::vector<SatelliteState> satellites;
+   Trails trails;              // where they have been lately
+   double earthRotation;       // radians
+   double lastEarthRotation;   // one step before
+   double time;                // simulator seconds since the start
+   double published;           // steady clock seconds when it was finished
+};
+
+/************************************************************************
+ * INTERPOLATE
+ * Where a satellite is a fraction of the way through its last step:
+ * 0 is where it started, 1 where it is now. Turns take the short way.
+ *************************************************************************/
+SatelliteState interpolate(const SatelliteState & state, double fraction);
+double interpolateRotation(double last, double rotation, double fraction);
+
+/************************************************************************
+ * DRAW SATELLITE
+ * Draw one satellite from its state
+ *************************************************************************/
+void drawSatellite(const SatelliteState & state);
@@ -0,0 +1,438 @@
+/***********************************************************************
+ * Source File:
+ *    Software Renderer : Draw frames into memory
+ * Author:
+ *    Emilio Regino, Bradley Payne, Penelope Sanchez
+ * Summary:
+ *    A small rasterizer following the same rules OpenGL does: a pixel
+ *    belongs to a triangle when its center is inside, and a center
+ *    exactly on an edge goes to only one of the triangles sharing it.
+ *    Setup and binning are serial and in frame order; only the filling
+ *    of tiles is spread across threads. Text is not drawn; the bitmap
+ *    font belongs to GLUT.
+ ************************************************************************/
+
+#include "softwareRenderer.h"   // for SOFTWARE RENDERER
+#include "parallel.h"           // for PARALLEL FOR
+#include <algorithm>            // for MIN, MAX, SWAP
+#include <cmath>                // for FLOOR, FABS
+#include <cassert>              // for ASSERT
+
+// what a binned primitive is: the top three bits of its entry
+const uint32_t KIND_POINT    = 0u << 29;
+const uint32_t KIND_TRIANGLE = 1u << 29;
+const uint32_t KIND_LINE     = 2u << 29;
+const uint32_t KIND_TRAIL    = 3u << 29;
+const uint32_t KIND_IMAGE    = 4u << 29;
+const uint32_t KIND_SPRITE   = 5u << 29;
+const uint32_t KIND_MASK     = 7u << 29;
+
+/*************************************************************************
+ * CONSTRUCTOR
+ *************************************************************************/
+SoftwareRenderer :: SoftwareRenderer(int width, int height, int workers) :
+   width(width), height(height), workers(workers < 1 ? 1 : workers),
+   tilesX((width + TILE_SIZE - 1) / TILE_SIZE),
+   tilesY((height + TILE_SIZE - 1) / TILE_SIZE),
+   pixels((size_t)width * height * 4)
+{
+   assert(width > 0 && height > 0);
+
+   tiles.resize(tilesX * tilesY);
+   for (int ty = 0; ty < tilesY; ty++)
+      for (int tx = 0; tx < tilesX; tx++)
+      {
+         Tile & tile = tiles[ty * tilesX + tx];
+         tile.left   = tx * TILE_SIZE;
+         tile.top    = ty * TILE_SIZE;
+         tile.right  = std::min(width,  tile.left + TILE_SIZE);
+         tile.bottom = std::min(height, tile.top  + TILE_SIZE);
+      }
+
+   // start out black, as after an empty frame
+   render(Frame());
+}
+
+/*************************************************************************
+ * RENDER
+ * Set up the triangles, sort everything into tiles, then fill the tiles
+ * in parallel
+ *************************************************************************/
+void SoftwareRenderer :: render(const Frame & frame)
+{
+   setup(frame);
+   bin(frame);
+
+   parallelFor(tiles.size(), workers, 4,
+               [this, &frame](int, size_t begin, size_t end)
+   {
+      for (size_t t = begin; t < end; t++)
+         fill(frame, tiles[t]);
+   });
+}
+
+/*************************************************************************
+ * SNAP
+ * Round to the nearest 256th of a pixel, as graphics cards do. With every
+ * vertex on that grid the edge tests below are exact, so a vertex lying
+ * on a neighbor's edge does not leave a crack.
+ *************************************************************************/
+static inline double snap(double coordinate)
+{
+   return floor(coordinate * 256.0 + 0.5) / 256.0;
+}
+
+/*************************************************************************
+ * ORIENT
+ * Twice the signed area of the triangle a, b, c: positive when c is on
+ * the inside of the edge a to b
+ *************************************************************************/
+static inline double orient(double ax, double ay, double bx, double by,
+                            double cx, double cy)
+{
+   return (bx - ax) * (cy - ay) - (by - ay) * (cx - ax);
+}
+
+/*************************************************************************
+ * IS TOP LEFT
+ * Does a pixel center exactly on the edge a to b belong to the triangle?
+ * Only for left edges (the inside is to the right) and flat top edges
+ * (the inside is below), so two triangles never both claim it.
+ *************************************************************************/
+static inline bool isTopLeft(double ax, double ay, double bx, double by)
+{
+   double nx = ay - by;   // points to the inside
+   double ny = bx - ax;
+   return nx > 0.0 || (nx == 0.0 && ny > 0.0);
+}
+
+/*************************************************************************
+ * SETUP
+ * Snap and wind every triangle, and find the pixels it could touch.
+ * Triangles with no area are given an empty box and never binned.
+ *************************************************************************/
+void SoftwareRenderer :: setup(const Frame & frame)
+{
+   triangles.resize(frame.triangles.size() / 3);
+   for (size_t i = 0; i < triangles.size(); i++)
+   {
+      const Vertex * v = &frame.triangles[i * 3];
+      Triangle & triangle = triangles[i];
+      for (int j = 0; j < 3; j++)
+      {
+         triangle.x[j] = snap(toColumn(v[j].x));
+         triangle.y[j] = snap(toRow(v[j].y));
+      }
+      triangle.rgba = v[0].rgba;
+
+      double area = orient(triangle.x[0], triangle.y[0], triangle.x[1], triangle.y[1],
+                           triangle.x[2], triangle.y[2]);
+      if (area == 0.0)
+      {
+         triangle.left = triangle.top = 0;
+         triangle.right = triangle.bottom = -1;
+         continue;
+      }
+      if (area < 0.0)
+      {
+         std::swap(triangle.x[1], triangle.x[2]);
+         std::swap(triangle.y[1], triangle.y[2]);
+      }
+
+      for (int j = 0; j < 3; j++)
+      {
+         int a = (j + 1) % 3;
+         int b = (j + 2) % 3;
+         triangle.topLeft[j] = isTopLeft(triangle.x[a], triangle.y[a],
+                                         triangle.x[b], triangle.y[b]);
+      }
+
+      triangle.left   = (int)floor(std::min(triangle.x[0], std::min(triangle.x[1], triangle.x[2])));
+      triangle.right  = (int)floor(std::max(triangle.x[0], std::max(triangle.x[1], triangle.x[2])));
+      triangle.top    = (int)floor(std::min(triangle.y[0], std::min(triangle.y[1], triangle.y[2])));
+      triangle.bottom = (int)floor(std::max(triangle.y[0], std::max(triangle.y[1], triangle.y[2])));
+   }
+}
+
+/*************************************************************************
+ * BIN RECT
+ * Add a primitive to every tile overlapping a box of pixels
+ *************************************************************************/
+void SoftwareRenderer :: binRect(uint32_t primitive, int left, int top, int right, int bottom)
+{
+   left   = std::max(left, 0);
+   top    = std::max(top, 0);
+   right  = std::min(right, width - 1);
+   bottom = std::min(bottom, height - 1);
+   if (left > right || top > bottom)
+      return;
+
+   for (int ty = top / TILE_SIZE; ty <= bottom / TILE_SIZE; ty++)
+      for (int tx = left / TILE_SIZE; tx <= right / TILE_SIZE; tx++)
+         tiles[ty * tilesX + tx].primitives.push_back(primitive);
+}
+
+/*************************************************************************
+ * BIN SEGMENTS
+ * Add every segment of an array to the tiles its box overlaps
+ *************************************************************************/
+void SoftwareRenderer :: binSegments(uint32_t kind, const std::vector<Vertex> & vertices)
+{
+   for (size_t i = 0; i + 1 < vertices.size(); i += 2)
+   {
+      double x0 = toColumn(vertices[i].x),     y0 = toRow(vertices[i].y);
+      double x1 = toColumn(vertices[i + 1].x), y1 = toRow(vertices[i + 1].y);
+      binRect(kind | (uint32_t)i,
+              (int)floor(std::min(x0, x1)), (int)floor(std::min(y0, y1)),
+              (int)floor(std::max(x0, x1)) + 1, (int)floor(std::max(y0, y1)) + 1);
+   }
+}
+
+/*************************************************************************
+ * BIN
+ * Sort the frame into tiles: points, then the image, trails, triangles,
+ * sprites, and lines, each in the order they were drawn, which is the
+ * order every tile paints them
+ *************************************************************************/
+void SoftwareRenderer :: bin(const Frame & frame)
+{
+   for (Tile & tile : tiles)
+      tile.primitives.clear();
+
+   for (size_t i = 0; i < frame.points.size(); i++)
+   {
+      int x = (int)floor(toColumn(frame.points[i].x));
+      int y = (int)floor(toRow(frame.points[i].y));
+      binRect(KIND_POINT | (uint32_t)i, x, y, x, y);
+   }
+
+   const Image & image = frame.image;
+   if (image.width > 0 && image.height > 0)
+   {
+      int left = (int)floor(toColumn(image.x));
+      int top  = (int)floor(toRow(image.y));
+      binRect(KIND_IMAGE, left, top, left + image.width - 1, top + image.height - 1);
+   }
+
+   binSegments(KIND_TRAIL, frame.trails);
+
+   for (size_t i = 0; i < triangles.size(); i++)
+      binRect(KIND_TRIANGLE | (uint32_t)i, triangles[i].left, triangles[i].top,
+              triangles[i].right, triangles[i].bottom);
+
+   if (frame.pAtlas)
+      for (size_t i = 0; i < frame.sprites.size(); i++)
+      {
+         const Sprite & sprite = frame.sprites[i];
+         int left = (int)floor(toColumn(sprite.x));
+         int top  = (int)floor(toRow(sprite.y));
+         binRect(KIND_SPRITE | (uint32_t)i, left, top,
+                 left + sprite.width - 1, top + sprite.height - 1);
+      }
+
+   binSegments(KIND_LINE, frame.lines);
+}
+
+/*************************************************************************
+ * FILL
+ * Paint one tile: black, then everything binned to it in order
+ *************************************************************************/
+void SoftwareRenderer :: fill(const Frame & frame, Tile & tile)
+{
+   for (int y = tile.top; y < tile.bottom; y++)
+   {
+      unsigned char * pixel = &pixels[((size_t)y * width + tile.left) * 4];
+      for (int x = tile.left; x < tile.right; x++, pixel += 4)
+      {
+         pixel[0] = 0;
+         pixel[1] = 0;
+         pixel[2] = 0;
+         pixel[3] = 255;
+      }
+   }
+
+   for (uint32_t primitive : tile.primitives)
+   {
+      uint32_t index = primitive & ~KIND_MASK;
+      switch (primitive & KIND_MASK)
+      {
+         case KIND_POINT:
+            drawPoint(tile, frame.points[index]);
+            break;
+         case KIND_TRIANGLE:
+            drawTriangle(tile, triangles[index]);
+            break;
+         case KIND_LINE:
+            drawLine(tile, frame.lines[index], frame.lines[index + 1], false);
+            break;
+         case KIND_TRAIL:
+            drawLine(tile, frame.trails[index], frame.trails[index + 1], true);
+            break;
+         case KIND_IMAGE:
+            drawImage(tile, frame.image);
+            break;
+         case KIND_SPRITE:
+            drawSprite(tile, *frame.pAtlas, frame.sprites[index]);
+            break;
+      }
+   }
+}
+
+/*************************************************************************
+ * PLOT
+ * Color one pixel, if it is on the tile
+ *************************************************************************/
+inline void SoftwareRenderer :: plot(const Tile & tile, int x, int y,
+                                     const unsigned char * rgba)
+{
+   if (x < tile.left || x >= tile.right || y < tile.top || y >= tile.bottom)
+      return;
+   unsigned char * pixel = &pixels[((size_t)y * width + x) * 4];
+   pixel[0] = rgba[0];
+   pixel[1] = rgba[1];
+   pixel[2] = rgba[2];
+   pixel[3] = rgba[3];
+}
+
+/*************************************************************************
+ * BLEND
+ * Mix a color into one pixel by its alpha, if the pixel is on the tile.
+ * The framebuffer stays opaque.
+ *************************************************************************/
+inline void SoftwareRenderer :: blend(const Tile & tile, int x, int y,
+                                      const unsigned char * rgba)
+{
+   if (x < tile.left || x >= tile.right || y < tile.top || y >= tile.bottom)
+      return;
+   unsigned char * pixel = &pixels[((size_t)y * width + x) * 4];
+   int alpha = rgba[3];
+   for (int i = 0; i < 3; i++)
+      pixel[i] = (unsigned char)((rgba[i] * alpha + pixel[i] * (255 - alpha) + 127) / 255);
+}
+
+/*************************************************************************
+ * DRAW POINT
+ * A point colors the one pixel it falls in
+ *************************************************************************/
+void SoftwareRenderer :: drawPoint(const Tile & tile, const Vertex & v)
+{
+   plot(tile, (int)floor(toColumn(v.x)), (int)floor(toRow(v.y)), v.rgba);
+}
+
+/*************************************************************************
+ * DRAW TRIANGLE
+ * Every pixel of the tile whose center is inside, in the color of the
+ * first vertex. The draw* functions give all three vertices the same
+ * color.
+ *************************************************************************/
+void SoftwareRenderer :: drawTriangle(const Tile & tile, const Triangle & triangle)
+{
+   const double * x = triangle.x;
+   const double * y = triangle.y;
+   int left   = std::max(tile.left,       triangle.left);
+   int right  = std::min(tile.right - 1,  triangle.right);
+   int top    = std::max(tile.top,        triangle.top);
+   int bottom = std::min(tile.bottom - 1, triangle.bottom);
+
+   for (int row = top; row <= bottom; row++)
+      for (int column = left; column <= right; column++)
+      {
+         double px = column + 0.5;
+         double py = row + 0.5;
+         double w0 = orient(x[1], y[1], x[2], y[2], px, py);
+         double w1 = orient(x[2], y[2], x[0], y[0], px, py);
+         double w2 = orient(x[0], y[0], x[1], y[1], px, py);
+         if ((w0 > 0.0 || (w0 == 0.0 && triangle.topLeft[0])) &&
+             (w1 > 0.0 || (w1 == 0.0 && triangle.topLeft[1])) &&
+             (w2 > 0.0 || (w2 == 0.0 && triangle.topLeft[2])))
+            plot(tile, column, row, triangle.rgba);
+      }
+}
+
+/*************************************************************************
+ * DRAW IMAGE
+ * Blend the part of the image over the tile in, pixel for pixel
+ *************************************************************************/
+void SoftwareRenderer :: drawImage(const Tile & tile, const Image & image)
+{
+   int left = (int)floor(toColumn(image.x));
+   int top  = (int)floor(toRow(image.y));
+   int firstColumn = std::max(tile.left, left);
+   int lastColumn  = std::min(tile.right, left + image.width);
+   int firstRow    = std::max(tile.top, top);
+   int lastRow     = std::min(tile.bottom, top + image.height);
+
+   for (int row = firstRow; row < lastRow; row++)
+   {
+      const unsigned char * rgba =
+         &image.rgba[((size_t)(row - top) * image.width + (firstColumn - left)) * 4];
+      for (int column = firstColumn; column < lastColumn; column++, rgba += 4)
+         if (rgba[3])
+            blend(tile, column, row, rgba);
+   }
+}
+
+/*************************************************************************
+ * DRAW SPRITE
+ * Copy the part of the sprite over the tile, skipping what is
+ * see-through. The atlas is either opaque or see-through, so nothing
+ * needs blending.
+ *************************************************************************/
+void SoftwareRenderer :: drawSprite(const Tile & tile, const Image & atlas,
+                                    const Sprite & sprite)
+{
+   int left = (int)floor(toColumn(sprite.x));
+   int top  = (int)floor(toRow(sprite.y));
+   int firstColumn = std::max(tile.left, left);
+   int lastColumn  = std::min(tile.right, left + sprite.width);
+   int firstRow    = std::max(tile.top, top);
+   int lastRow     = std::min(tile.bottom, top + sprite.height);
+
+   for (int row = firstRow; row < lastRow; row++)
+   {
+      const unsigned char * rgba =
+         &atlas.rgba[((size_t)(sprite.v + row - top) * atlas.width +
+                      sprite.u + firstColumn - left) * 4];
+      for (int column = firstColumn; column < lastColumn; column++, rgba += 4)
+         if (rgba[3])
+            plot(tile, column, row, rgba);
+   }
+}
+
+/*************************************************************************
+ * DRAW LINE
+ * One pixel per step along the longer axis, leaving off the last one
+ * so connected segments do not color their shared end twice. Only the
+ * pixels on the tile are colored, either outright or blended in.
+ *************************************************************************/
+void SoftwareRenderer :: drawLine(const Tile & tile, const Vertex & v0, const Vertex & v1,
+                                  bool blended)
+{
+   double x0 = toColumn(v0.x), y0 = toRow(v0.y);
+   double x1 = toColumn(v1.x), y1 = toRow(v1.y);
+   double dx = x1 - x0;
+   double dy = y1 - y0;
+
+   if (fabs(dx) >= fabs(dy))
+   {
+      if (dx == 0.0)
+         return;
+      int first = std::max((int)floor(std::min(x0, x1) + 0.5), tile.left);
+      int last  = std::min((int)floor(std::max(x0, x1) + 0.5), tile.right);
+      for (int x = first; x < last; x++)
+      {
+         int y = (int)floor(y0 + (x + 0.5 - x0) * dy / dx);
+         blended ? blend(tile, x, y, v0.rgba) : plot(tile, x, y, v0.rgba);
+      }
+   }
+   else
+   {
+      int first = std::max((int)floor(std::min(y0, y1) + 0.5), tile.top);
+      int last  = std::min((int)floor(std::max(y0, y1) + 0.5), tile.bottom);
+      for (int y = first; y < last; y++)
+      {
+         int x = (int)floor(x0 + (y + 0.5 - y0) * dx / dy);
+         blended ? blend(tile, x, y, v0.rgba) : plot(tile, x, y, v0.rgba);
+      }
+   }
+}
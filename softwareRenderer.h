@@ -0,0 +1,98 @@
+/***********************************************************************
+ * Header File:
+ *    Software Renderer : Draw frames into memory
+ * Author:
+ *    Emilio Regino, Bradley Payne, Penelope Sanchez
+ * Summary:
+ *    A renderer that needs no window and no graphics card. Each frame
+ *    is painted into an RGBA framebuffer in memory, where it can be
+ *    looked at, saved, or compared against a known-good picture.
+ *
+ *    The framebuffer is cut into square tiles. Everything in the frame
+ *    is first sorted into the tiles it touches, then the tiles are
+ *    filled in parallel, each by one worker, in frame order. No two
+ *    workers ever write the same pixel, so the picture is the same byte
+ *    for byte whatever the number of workers.
+ ************************************************************************/
+
+#pragma once
+
+#include "renderer.h"   // for RENDERER
+#include <vector>       // for VECTOR
+#include <cstdint>      // for UINT32_T
+
+class TestSoftwareRenderer;
+
+// tiles are TILE_SIZE pixels on a side
+const int TILE_SIZE = 64;
+
+/************************************************************
+ * SOFTWARE RENDERER
+ * Paints frames into a width by height framebuffer, four
+ * bytes per pixel, with row 0 at the top. The center of the
+ * framebuffer is the center of the screen.
+ ************************************************************/
+class SoftwareRenderer : public Renderer
+{
+public:
+   friend TestSoftwareRenderer;
+
+   SoftwareRenderer(int width, int height, int workers = 1);
+
+   void render(const Frame & frame);
+
+   int getWidth()  const { return width;  }
+   int getHeight() const { return height; }
+   const unsigned char * getPixels() const { return pixels.data(); }
+
+private:
+   // the part of the framebuffer one worker fills
+   struct Tile
+   {
+      int left;
+      int top;
+      int right;        // one past the last column
+      int bottom;       // one past the last row
+      std::vector<uint32_t> primitives;   // kind and index, in frame order
+   };
+
+   // a triangle ready to fill: corners snapped and wound one way
+   struct Triangle
+   {
+      double x[3];
+      double y[3];
+      bool topLeft[3];  // which edges keep pixel centers right on them
+      int left;
+      int top;
+      int right;        // last column it could touch
+      int bottom;       // last row it could touch
+      const unsigned char * rgba;
+   };
+
+   void setup(const Frame & frame);
+   void bin(const Frame & frame);
+   void fill(const Frame & frame, Tile & tile);
+
+   void plot(const Tile & tile, int x, int y, const unsigned char * rgba);
+   void blend(const Tile & tile, int x, int y, const unsigned char * rgba);
+   void drawPoint(const Tile & tile, const Vertex & v);
+   void drawTriangle(const Tile & tile, const Triangle & triangle);
+   void drawLine(const Tile & tile, const Vertex & v0, const Vertex & v1, bool blended);
+   void drawImage(const Tile & tile, const Image & image);
+   void drawSprite(const Tile & tile, const Image & atlas, const Sprite & sprite);
+   void binRect(uint32_t primitive, int left, int top, int right, int bottom);
+   void binSegments(uint32_t kind, const std::vector<Vertex> & vertices);
+
+   // from pixels around the center with y up, to the framebuffer
+   double toColumn(float x) const { return x + width  / 2.0; }
+   double toRow(float y)    const { return height / 2.0 - y; }
+
+   int width;
+   int height;
+   int workers;                       // most threads to fill with
+   int tilesX;                        // tiles across
+   int tilesY;                        // tiles down
+   std::vector<unsigned char> pixels;
+   std::vector<Tile> tiles;
+   std::vector<Triangle> triangles;   // this frame's, set up
+};
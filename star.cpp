@@ -83,3 +83,33 @@ void Star :: draw()
 {
    drawStar(position, phase++);
 }
+
+/*************************************************************************
+ * STAR FIELD(PTBOUNDARY, NUM)
+ * Scatter num stars within the boundary, each starting at a random
+ * phase, the same way a single star is placed.
+ *************************************************************************/
+StarField :: StarField(const Position& ptBoundary, int num)
+{
+   positions.reserve(num);
+   phases.reserve(num);
+   for (int i = 0; i < num; i++)
+   {
+      Position position;
+      position.setMetersX(random(-ptBoundary.getMetersX(), ptBoundary.getMetersX()));
+      position.setMetersY(random(-ptBoundary.getMetersY(), ptBoundary.getMetersY()));
+      positions.push_back(position);
+      phases.push_back(random(0, 255));
+   }
+}
+
+/*************************************************************************
+ * DRAW
+ * A method to draw the whole star field and advance every twinkle
+ *************************************************************************/
+void StarField :: draw()
+{
+   drawStars(positions.data(), phases.data(), positions.size());
+   for (auto & phase : phases)
+      phase++;
+}
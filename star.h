@@ -11,6 +11,7 @@
 #pragma once
 
 #include <cassert>
+#include <vector>       // for VECTOR
 #include "position.h"   // for POSITION
 #include "uiDraw.h"     // for OGSTREAM
 
@@ -35,3 +36,24 @@ private:
    Position position;
    unsigned char phase;
 };
+
+/**************************************************
+ * STAR FIELD
+ * Every star in the sky, kept side by side so the
+ * whole field is drawn in one go
+ *************************************************/
+class StarField
+{
+public:
+   // constructor
+   StarField(const Position& ptBoundary, int num);
+
+   size_t size() const { return positions.size(); }
+
+   // drawers
+   void draw();
+
+private:
+   std::vector<Position> positions;
+   std::vector<unsigned char> phases;
+};
@@ -12,6 +12,17 @@
 #include "testAngle.h"
 #include "testSatellite.h"
 #include "testAcceleration.h"
+#include "testCollisionScheduler.h"
+#include "testConjunction.h"
+#include "testCollisionGrid.h"
+#include "testCollisionEvent.h"
+#include "testSoftwareRenderer.h"
+#include "testCommandList.h"
+#include "testTripleBuffer.h"
+#include "testTrails.h"
+#include "testHeatMap.h"
+#include "testFrameCapture.h"
+#include "testSimulator.h"
 
 /*****************************************************************
  * TEST RUNNER
@@ -21,6 +32,17 @@ void testRunner()
 {
    TestPosition().run();
    TestAngle().run();
+   TestCollisionScheduler().run();
+   TestConjunction().run();
+   TestCollisionGrid().run();
+   TestCollisionEvent().run();
+   TestSoftwareRenderer().run();
+   TestCommandList().run();
+   TestTripleBuffer().run();
+   TestTrails().run();
+   TestHeatMap().run();
+   TestFrameCapture().run();
+   TestSimulator().run();
 //   TestSatellite().run();
 //   TestAcceleration().run();
 }
@@ -0,0 +1,161 @@
+/***********************************************************************
+ * Header File:
+ *    Test Collision Event : The test suite for collision events
+ * Authors:
+ *    Emilio Regino, Bradley Payne
+ * Summary:
+ *    All the unit tests for recording collisions as events and breaking
+ *    up everything that collided in one batch
+ ************************************************************************/
+
+#pragma once
+
+#include "simulator.h"       // for SIMULATOR
+#include "collisionEvent.h"  // for COLLISION EVENT
+#include <cassert>           // for ASSERT
+#include <iostream>          // for COUT
+#include <list>              // for LIST
+#include <vector>            // for VECTOR
+using namespace std;
+
+/*******************************
+ * TEST COLLISION EVENT
+ * A friend class for Simulator which contains the unit tests
+ * for its collision events
+ ********************************/
+class TestCollisionEvent
+{
+public:
+   void run()
+   {
+      cout << "Collision Event: ";
+      test_breakup_onceEach();
+      test_breakup_spawnedAfter();
+      test_breakup_notifiesOnce();
+      test_tally_counts();
+      cout << "Passed\n";
+   }
+
+private:
+   // hears every frame's events, and how many times it was told
+   class Listener : public CollisionListener
+   {
+   public:
+      Listener() : calls(0) {}
+      void notify(const vector<CollisionEvent> & events)
+      {
+         calls++;
+         heard = events;
+      }
+      int calls;
+      vector<CollisionEvent> heard;
+   };
+
+   // a simulator holding only the given satellites
+   static void populate(Simulator & simulator, const list<Satellite *> & satellites)
+   {
+      for (auto satellite : simulator.satellites)
+         delete satellite;
+      simulator.satellites = satellites;
+   }
+
+   static Position upperRight()
+   {
+      Position pt;
+      pt.setPixelsX(100.0);
+      pt.setPixelsY(100.0);
+      return pt;
+   }
+
+   // a GPS hit twice breaks into its five pieces only once
+   void test_breakup_onceEach()
+   {
+      // setup
+      Simulator simulator(upperRight());
+      Satellite * gps1 = new GPS(Position(0.0, 26560000.0), Velocity());
+      Satellite * gps2 = new GPS(Position(5000.0, 26560000.0), Velocity());
+      Satellite * gps3 = new GPS(Position(-5000.0, 26560000.0), Velocity());
+      populate(simulator, { gps1, gps2, gps3 });
+      simulator.contacts = { { gps1, gps2 }, { gps1, gps3 } };
+
+      // exercise
+      simulator.breakup();
+
+      // verify
+      assert(simulator.events.size() == 2);
+      assert(simulator.broken.size() == 3);
+      assert(simulator.satellites.size() == 3 * 5);
+   }  // teardown
+
+   // the pieces join behind everything that was already there
+   void test_breakup_spawnedAfter()
+   {
+      // setup
+      Simulator simulator(upperRight());
+      Satellite * gps1 = new GPS(Position(0.0, 26560000.0), Velocity());
+      Satellite * gps2 = new GPS(Position(5000.0, 26560000.0), Velocity());
+      Satellite * bystander = new GPS(Position(0.0, -26560000.0), Velocity());
+      populate(simulator, { gps1, gps2, bystander });
+      simulator.contacts = { { gps1, gps2 } };
+
+      // exercise
+      simulator.breakup();
+
+      // verify
+      assert(simulator.satellites.size() == 1 + 2 * 5);
+      assert(simulator.satellites.front() == bystander);
+      assert(!bystander->isDead());
+   }  // teardown
+
+   // every listener hears the whole frame once, after the breakup
+   void test_breakup_notifiesOnce()
+   {
+      // setup
+      Simulator simulator(upperRight());
+      Listener listener;
+      simulator.subscribe(&listener);
+      Satellite * gps1 = new GPS(Position(0.0, 26560000.0), Velocity(100.0, 0.0));
+      Satellite * gps2 = new GPS(Position(5000.0, 26560000.0), Velocity());
+      Satellite * gps3 = new GPS(Position(-5000.0, 26560000.0), Velocity());
+      unsigned int id1 = gps1->getId();
+      unsigned int id2 = gps2->getId();
+      unsigned int id3 = gps3->getId();
+      populate(simulator, { gps1, gps2, gps3 });
+      simulator.contacts = { { gps1, gps2 }, { gps1, gps3 } };
+
+      // exercise
+      simulator.breakup();
+
+      // verify
+      assert(listener.calls == 1);
+      assert(listener.heard.size() == 2);
+      assert(listener.heard[0].id1 == id1);
+      assert(listener.heard[0].id2 == id2);
+      assert(listener.heard[1].id1 == id1);
+      assert(listener.heard[1].id2 == id3);
+      assert(listener.heard[0].dvx == 100.0);
+      assert(listener.heard[0].x == 2500.0);
+   }  // teardown
+
+   // the simulator's own tally tells collisions from impacts
+   void test_tally_counts()
+   {
+      // setup
+      Simulator simulator(upperRight());
+      Satellite * gps1 = new GPS(Position(0.0, 26560000.0), Velocity(30.0, 40.0));
+      Satellite * gps2 = new GPS(Position(5000.0, 26560000.0), Velocity());
+      Satellite * gps3 = new GPS(Position(-5000.0, 26560000.0), Velocity());
+      Satellite * grounded = new GPS(Position(0.0, 1000.0), Velocity(0.0, -10.0));
+      populate(simulator, { gps1, gps2, gps3, grounded });
+      simulator.contacts = { { gps1, gps2 }, { gps1, gps3 }, { grounded, NULL } };
+
+      // exercise
+      simulator.breakup();
+
+      // verify
+      const CollisionTally & tally = simulator.getTally();
+      assert(tally.getCollisions() == 2);
+      assert(tally.getImpacts() == 1);
+      assert(tally.getFastest() == 50.0);
+   }  // teardown
+};
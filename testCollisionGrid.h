@@ -0,0 +1,160 @@
+/***********************************************************************
+ * Header File:
+ *    Test Collision Grid : The test suite for the collision grid
+ * Authors:
+ *    Emilio Regino, Bradley Payne
+ * Summary:
+ *    All the unit tests for parallel grid-based collision detection
+ ************************************************************************/
+
+#pragma once
+
+#include "collisionGrid.h"  // for COLLISION GRID
+#include <cassert>          // for ASSERT
+#include <iostream>         // for COUT
+#include <list>             // for LIST
+#include <vector>           // for VECTOR
+using namespace std;
+
+/*******************************
+ * TEST COLLISION GRID
+ * A friend class for CollisionGrid which contains its unit tests
+ ********************************/
+class TestCollisionGrid
+{
+public:
+   void run()
+   {
+      cout << "Collision Grid: ";
+      Position().setZoom(1000.0 /* 1km equals 1 pixel */);
+      test_detect_touching();
+      test_detect_neighborCell();
+      test_detect_earth();
+      test_detect_sameForAnyWorkers();
+      test_testPairs_blockAndTail();
+      cout << "Passed\n";
+   }
+
+private:
+   // two satellites on top of each other die, one far away does not
+   void test_detect_touching()
+   {
+      // setup
+      CollisionGrid grid(1);
+      GPS gps1(Position(0.0, 26560000.0), Velocity());
+      GPS gps2(Position(5000.0, 26560000.0), Velocity());
+      GPS gps3(Position(0.0, -26560000.0), Velocity());
+      list<Satellite *> satellites = { &gps1, &gps2, &gps3 };
+      vector<Contact> contacts;
+
+      // exercise
+      grid.detect(satellites, contacts);
+
+      // verify
+      assert(contacts.size() == 1);
+      assert(contacts[0].pSatellite1 == &gps1);
+      assert(contacts[0].pSatellite2 == &gps2);
+      assert(gps1.isDead());
+      assert(gps2.isDead());
+      assert(!gps3.isDead());
+   }  // teardown
+
+   // touching across a cell boundary still counts
+   void test_detect_neighborCell()
+   {
+      // setup
+      CollisionGrid grid(1);
+      GPS gps1(Position(-1000.0, 26560000.0), Velocity());
+      GPS gps2(Position( 1000.0, 26560000.0), Velocity());
+      list<Satellite *> satellites = { &gps1, &gps2 };
+      vector<Contact> contacts;
+
+      // exercise
+      grid.detect(satellites, contacts);
+
+      // verify
+      assert(grid.cellKeys.size() == 2);
+      assert(contacts.size() == 1);
+   }  // teardown
+
+   // a satellite inside the earth is grounded
+   void test_detect_earth()
+   {
+      // setup
+      CollisionGrid grid(1);
+      GPS gps(Position(0.0, 1000.0), Velocity());
+      list<Satellite *> satellites = { &gps };
+      vector<Contact> contacts;
+
+      // exercise
+      grid.detect(satellites, contacts);
+
+      // verify
+      assert(contacts.size() == 1);
+      assert(contacts[0].pSatellite2 == NULL);
+      assert(gps.isDead());
+   }  // teardown
+
+   // a crowd in a line finds the same contacts with one worker or many
+   void test_detect_sameForAnyWorkers()
+   {
+      // setup
+      vector<unsigned int> ids[2];
+      for (int run = 0; run < 2; run++)
+      {
+         CollisionGrid grid(run == 0 ? 1 : 4);
+         vector<GPS> crowd;
+         crowd.reserve(2000);
+         for (int i = 0; i < 2000; i++)
+            crowd.push_back(GPS(Position(i * 15000.0, 30000000.0 + (i % 7) * 9000.0), Velocity()));
+         list<Satellite *> satellites;
+         for (auto & gps : crowd)
+            satellites.push_back(&gps);
+         vector<Contact> contacts;
+
+         // exercise
+         grid.detect(satellites, contacts);
+
+         for (auto & contact : contacts)
+         {
+            ids[run].push_back(contact.pSatellite1->getId() - crowd[0].getId());
+            ids[run].push_back(contact.pSatellite2->getId() - crowd[0].getId());
+         }
+      }
+
+      // verify
+      assert(!ids[0].empty());
+      assert(ids[0] == ids[1]);
+   }  // teardown
+
+   // a full group of lanes and a partial one each report the right hits
+   void test_testPairs_blockAndTail()
+   {
+      // setup
+      double xs[]    = { 0.0, 3.0, 10.0, 0.0, 100.0, 104.0 };
+      double ys[]    = { 0.0, 4.0,  0.0, 9.0,   0.0,   0.0 };
+      double radii[] = { 2.5, 2.6,  1.0, 1.0,   2.0,   2.1 };
+      CandidatePair pairs[] =
+      {
+         { 0, 1 },   // 5 apart, reach 5.1
+         { 0, 3 },   // 9 apart, reach 3.5
+         { 4, 5 },   // 4 apart, reach 4.1
+         { 1, 3 },   // 5.8 apart, reach 3.6
+         { 0, 2 },   // 10 apart, reach 3.5
+         { 1, 0 },   // same as the first, reversed
+      };
+      unsigned char hits[6] = { 9, 9, 9, 9, 9, 9 };
+
+      // exercise
+      size_t numHits = testPairs(xs, ys, radii, pairs, 6, hits);
+
+      // verify
+      assert(numHits == 3);
+      assert(hits[0] == 1);
+      assert(hits[1] == 0);
+      assert(hits[2] == 1);
+      assert(hits[3] == 0);
+      assert(hits[4] == 0);
+      assert(hits[5] == 1);
+   }  // teardown
+};
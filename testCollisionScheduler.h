@@ -0,0 +1,147 @@
+/***********************************************************************
+ * Header File:
+ *    Test Collision Scheduler : The test suite for the collision scheduler
+ * Authors:
+ *    Emilio Regino, Bradley Payne
+ * Summary:
+ *    All the unit tests for the event-driven collision scheduler
+ ************************************************************************/
+
+#pragma once
+
+#include "collisionScheduler.h"  // for COLLISION SCHEDULER
+#include <cassert>               // for ASSERT
+#include <iostream>              // for COUT
+#include <vector>                // for VECTOR
+using namespace std;
+
+/*******************************
+ * TEST COLLISION SCHEDULER
+ * A friend class for CollisionScheduler which contains its unit tests
+ ********************************/
+class TestCollisionScheduler
+{
+public:
+   void run()
+   {
+      cout << "Collision Scheduler: ";
+      Position().setZoom(1000.0 /* 1km equals 1 pixel */);
+      test_timeToClose_touching();
+      test_timeToClose_coasting();
+      test_insert_overlapping();
+      test_insert_apart();
+      test_insert_earth();
+      test_remove_stale();
+      cout << "Passed\n";
+   }
+
+private:
+   // utility funciton because floating point numbers are approximations
+   bool closeEnough(double value, double test, double tolerence) const
+   {
+      double difference = value - test;
+      return (difference >= -tolerence) && (difference <= tolerence);
+   }
+
+   // a pair already touching has no time left
+   void test_timeToClose_touching()
+   {
+      // exercise
+      double t = CollisionScheduler::timeToClose(-5.0, 100.0, 10.0);
+
+      // verify
+      assert(t == 0.0);
+   }  // teardown
+
+   // with no acceleration the gap closes at the closing speed
+   void test_timeToClose_coasting()
+   {
+      // exercise
+      double t = CollisionScheduler::timeToClose(1000.0, 100.0, 0.0);
+
+      // verify
+      assert(closeEnough(t, 10.0, 0.0001));
+   }  // teardown
+
+   // two satellites on top of each other collide right away
+   void test_insert_overlapping()
+   {
+      // setup
+      CollisionScheduler scheduler;
+      GPS gps1(Position(0.0, 26560000.0), Velocity(-3880.0, 0.0));
+      GPS gps2(Position(0.0, 26560000.0), Velocity( 3880.0, 0.0));
+      vector<Contact> contacts;
+
+      // exercise
+      scheduler.insert(&gps1, 0.0);
+      scheduler.insert(&gps2, 0.0);
+      scheduler.advance(0.0, contacts);
+
+      // verify
+      assert(contacts.size() == 1);
+      assert(contacts[0].pSatellite2 != NULL);
+      assert(!scheduler.isTracked(&gps1));
+      assert(!scheduler.isTracked(&gps2));
+   }  // teardown
+
+   // two satellites on opposite sides of the earth get a future certificate
+   void test_insert_apart()
+   {
+      // setup
+      CollisionScheduler scheduler;
+      GPS gps1(Position(0.0,  26560000.0), Velocity(-3880.0, 0.0));
+      GPS gps2(Position(0.0, -26560000.0), Velocity( 3880.0, 0.0));
+      vector<Contact> contacts;
+
+      // exercise
+      scheduler.insert(&gps1, 0.0);
+      scheduler.insert(&gps2, 0.0);
+      scheduler.advance(0.0, contacts);
+
+      // verify
+      assert(contacts.empty());
+      assert(scheduler.getPending() == 3);  // the pair and each against the earth
+      assert(scheduler.events.top().time > TIME_PER_FRAME);
+      assert(scheduler.isTracked(&gps1));
+      assert(scheduler.isTracked(&gps2));
+   }  // teardown
+
+   // a satellite inside the earth hits the earth
+   void test_insert_earth()
+   {
+      // setup
+      CollisionScheduler scheduler;
+      GPS gps(Position(0.0, 1000.0), Velocity(0.0, 0.0));
+      vector<Contact> contacts;
+
+      // exercise
+      scheduler.insert(&gps, 0.0);
+      scheduler.advance(0.0, contacts);
+
+      // verify
+      assert(contacts.size() == 1);
+      assert(contacts[0].pSatellite1 == &gps);
+      assert(contacts[0].pSatellite2 == NULL);
+   }  // teardown
+
+   // certificates of a removed satellite are ignored when they come due
+   void test_remove_stale()
+   {
+      // setup
+      CollisionScheduler scheduler;
+      GPS gps1(Position(0.0, 26560000.0), Velocity(-3880.0, 0.0));
+      GPS gps2(Position(0.0, 26560000.0), Velocity( 3880.0, 0.0));
+      vector<Contact> contacts;
+      scheduler.insert(&gps1, 0.0);
+      scheduler.insert(&gps2, 0.0);
+
+      // exercise
+      scheduler.remove(&gps2);
+      scheduler.advance(0.0, contacts);
+
+      // verify
+      assert(contacts.empty());
+      assert(scheduler.isTracked(&gps1));
+      assert(!scheduler.isTracked(&gps2));
+   }  // teardown
+};
@@ -0,0 +1,336 @@
+/***********************************************************************
+ * Header File:
+ *    Test Command List : The test suite for recorded drawing
+ * Authors:
+ *    Emilio Regino, Bradley Payne
+ * Summary:
+ *    All the unit tests for CommandList
+ ************************************************************************/
+
+#pragma once
+
+#include "commandList.h"       // for COMMAND LIST
+#include "softwareRenderer.h"  // for SOFTWARE RENDERER
+#include "uiDraw.h"            // for the draw* functions
+#include "satellite.h"         // for GPS LEFT
+#include <sstream>             // for STRINGSTREAM
+#include <thread>              // for THREAD
+#include <cassert>             // for ASSERT
+#include <iostream>            // for COUT
+using namespace std;
+
+/*******************************
+ * TEST COMMAND LIST
+ * A friend class for CommandList which contains its unit tests
+ ********************************/
+class TestCommandList
+{
+public:
+   void run()
+   {
+      cout << "Command List: ";
+      test_record_compact();
+      test_replay_sameAsDrawing();
+      test_record_onWorker();
+      test_replay_detail();
+      test_snapshot_gpsLeftIsLeft();
+      test_flush_sortsByColor();
+      test_flush_countsStats();
+      test_sprites_sameUnturned();
+      test_compare_firstDifference();
+      test_save_load();
+      cout << "Passed\n";
+   }
+
+private:
+   Position pixels(double x, double y)
+   {
+      Position pt;
+      pt.setPixelsX(x);
+      pt.setPixelsY(y);
+      return pt;
+   }
+
+   // each command is its opcode and its floats, nothing more
+   void test_record_compact()
+   {
+      // setup
+      CommandList list;
+      CommandList * pSaved = recordInto(&list);
+
+      // exercise
+      drawFragment(pixels(10.0, 20.0), 0.5);
+      drawGPSRight(pixels(10.0, 20.0), 0.5, pixels(0.0, 12.0));
+      drawProjectile(pixels(-3.0, 4.0));
+      drawText(pixels(0.0, 0.0), "hi");
+      recordInto(pSaved);
+
+      // verify
+      assert(list.count() == 4);
+      assert(list.size() == (1 + 12) + (1 + 20) + (1 + 8) + (1 + 8 + 2 + 2));
+      assert(list.bytes[0] == OP_FRAGMENT);
+      assert(list.bytes[13] == OP_GPS_RIGHT);
+   }  // teardown
+
+   // playing a list back draws the same picture as drawing right away
+   void test_replay_sameAsDrawing()
+   {
+      // setup
+      SoftwareRenderer immediate(64, 64);
+      SoftwareRenderer recorded(64, 64);
+      double flame[4] = { 2.0, -20.0, -1.0, -16.0 };
+      CommandList list;
+
+      // exercise
+      CommandList * pSaved = recordInto(NULL);
+      drawShip(pixels(3.0, 5.0), 0.7, flame);
+      drawHubble(pixels(-12.0, -9.0), 2.0);
+      setRenderer(&immediate);
+      drawFlush();
+
+      recordInto(&list);
+      drawShip(pixels(3.0, 5.0), 0.7, flame);
+      drawHubble(pixels(-12.0, -9.0), 2.0);
+      recordInto(pSaved);
+      drawCommands(list);
+      setRenderer(&recorded);
+      drawFlush();
+      setRenderer(NULL);
+
+      // verify
+      assert(list.count() == 5);
+      assert(lastFrameCommands().compare(list) == list.count());
+      for (int i = 0; i < 64 * 64 * 4; i++)
+         assert(immediate.getPixels()[i] == recorded.getPixels()[i]);
+   }  // teardown
+
+   // a worker thread records into its own list, and the drawing thread
+   // hands it to the frame
+   void test_record_onWorker()
+   {
+      // setup
+      SoftwareRenderer direct(64, 64);
+      SoftwareRenderer handed(64, 64);
+      setRenderer(&direct);
+      drawHubble(pixels(-12.0, -9.0), 2.0);
+      drawSputnik(pixels(10.0, 10.0), 0.3);
+      drawFlush();
+      CommandList list;
+
+      // exercise
+      thread worker([this, &list]()
+      {
+         recordInto(&list);
+         drawHubble(pixels(-12.0, -9.0), 2.0);
+         drawSputnik(pixels(10.0, 10.0), 0.3);
+      });
+      worker.join();
+      drawCommands(list);
+      setRenderer(&handed);
+      drawFlush();
+      setRenderer(NULL);
+
+      // verify
+      assert(list.count() == 4 + 1);
+      for (int i = 0; i < 64 * 64 * 4; i++)
+         assert(direct.getPixels()[i] == handed.getPixels()[i]);
+   }  // teardown
+
+   // from far away a part is one dot in its main color, and the level
+   // goes back to full at the end of the frame
+   void test_replay_detail()
+   {
+      // setup
+      SoftwareRenderer renderer(32, 32);
+      setRenderer(&renderer);
+      drawDetail(DETAIL_POINT);
+      drawFragment(pixels(0.5, 0.5), 0.0);
+
+      // exercise
+      drawFlush();
+
+      // verify
+      int lit = 0;
+      for (int i = 0; i < 32 * 32; i++)
+         if (renderer.getPixels()[i * 4] != 0)
+         {
+            assert(renderer.getPixels()[i * 4] == 196);   // light grey
+            lit++;
+         }
+      assert(lit == 1);
+
+      drawFragment(pixels(0.5, 0.5), 0.0);
+      drawFlush();
+      lit = 0;
+      for (int i = 0; i < 32 * 32; i++)
+         lit += (renderer.getPixels()[i * 4] != 0);
+      assert(lit == 16);   // 8 by 2
+      setRenderer(NULL);
+   }  // teardown
+
+   // the left array of a GPS is drawn as the left array; the original
+   // drew it as a right one
+   void test_snapshot_gpsLeftIsLeft()
+   {
+      // setup
+      SoftwareRenderer drawn(64, 64);
+      SoftwareRenderer left(64, 64);
+      SoftwareRenderer right(64, 64);
+      GPS gps(Position(0.0, 0.0), Velocity(0.0, 0.0));
+      GPSLeft part(gps, Angle(230), 8.0);
+      SatelliteState state = part.getState();
+      Position center(state.x, state.y);
+
+      // exercise
+      setRenderer(&drawn);
+      drawSatellite(state);
+      drawFlush();
+      setRenderer(&left);
+      drawGPSLeft(center, state.rotation);
+      drawFlush();
+      setRenderer(&right);
+      drawGPSRight(center, state.rotation);
+      drawFlush();
+      setRenderer(NULL);
+
+      // verify
+      assert(state.kind == KIND_GPS_LEFT);
+      int lit = 0;
+      int sameAsRight = 0;
+      for (int i = 0; i < 64 * 64 * 4; i++)
+      {
+         assert(drawn.getPixels()[i] == left.getPixels()[i]);
+         lit += (i % 4 == 0) && drawn.getPixels()[i] != 0;
+         sameAsRight += drawn.getPixels()[i] == right.getPixels()[i];
+      }
+      assert(lit > 0);
+      assert(sameAsRight < 64 * 64 * 4);
+   }  // teardown
+
+   // copies of a part go out a color at a time, not a part at a time
+   void test_flush_sortsByColor()
+   {
+      // setup
+      NullRenderer renderer;
+      setRenderer(&renderer);
+      drawGPSCenter(pixels(-10.0, 0.0), 0.0);   // gold, white, then grey
+      drawGPSCenter(pixels(10.0, 0.0), 0.0);
+
+      // exercise
+      drawFlush();
+
+      // verify
+      StateChanges changes = lastFrameStateChanges();
+      assert(changes.unsorted == 6);
+      assert(changes.sorted == 3);
+      setRenderer(NULL);
+   }  // teardown
+
+   // the stats are of the last frame, and are back to 0 for the next
+   void test_flush_countsStats()
+   {
+      // setup
+      NullRenderer renderer;
+      setRenderer(&renderer);
+      drawGPSCenter(pixels(-10.0, 0.0), 0.0);
+      drawGPSCenter(pixels(10.0, 0.0), 0.0);
+      countCulled(5);
+
+      // exercise
+      drawFlush();
+      RenderStats first = lastFrameStats();
+      drawFlush();
+      RenderStats second = lastFrameStats();
+
+      // verify
+      size_t on = RENDER_STATS ? 1 : 0;
+      assert(first.drawCalls == 2 * on);
+      assert(first.rotations == 2 * on);
+      assert(first.colorChanges == 3 * on);
+      assert(first.culled == 5 * on);
+      assert((first.vertices > 0) == RENDER_STATS);
+      assert(first.sprites == 0);
+      assert(second.drawCalls == 0);
+      assert(second.vertices == 0);
+      assert(second.culled == 0);
+      setRenderer(NULL);
+   }  // teardown
+
+   // unturned, a part drawn as a sprite is the same picture as its shapes
+   void test_sprites_sameUnturned()
+   {
+      // setup
+      SoftwareRenderer shapes(64, 64);
+      SoftwareRenderer sprites(64, 64);
+      setRenderer(&shapes);
+      drawGPS(pixels(0.0, 0.0), 0.0);
+      drawFragment(pixels(-20.0, 20.0), 0.0);
+      drawFlush();
+
+      // exercise
+      setPartSprites(true);
+      setRenderer(&sprites);
+      drawGPS(pixels(0.0, 0.0), 0.0);
+      drawFragment(pixels(-20.0, 20.0), 0.0);
+      drawFlush();
+      RenderStats stats = lastFrameStats();
+      setPartSprites(false);
+      setRenderer(NULL);
+
+      // verify
+      assert((stats.sprites > 0) == RENDER_STATS);
+      assert(stats.drawCalls == (RENDER_STATS ? 4 : 0));
+      int lit = 0;
+      for (int i = 0; i < 64 * 64 * 4; i++)
+      {
+         assert(shapes.getPixels()[i] == sprites.getPixels()[i]);
+         lit += (shapes.getPixels()[i] != 0);
+      }
+      assert(lit > 0);
+   }  // teardown
+
+   // the first command that differs is found, not just that one does
+   void test_compare_firstDifference()
+   {
+      // setup
+      CommandList lhs;
+      CommandList rhs;
+      lhs.projectile(pixels(1.0, 1.0));
+      rhs.projectile(pixels(1.0, 1.0));
+      lhs.part(OP_SPUTNIK, pixels(5.0, 5.0), 1.0);
+      rhs.part(OP_SPUTNIK, pixels(5.0, 5.0), 1.25);
+      lhs.projectile(pixels(2.0, 2.0));
+      rhs.projectile(pixels(2.0, 2.0));
+
+      // exercise
+      size_t different = lhs.compare(rhs);
+      size_t same = lhs.compare(lhs);
+
+      // verify
+      assert(different == 1);
+      assert(same == 3);
+   }  // teardown
+
+   // a saved list loads back byte for byte
+   void test_save_load()
+   {
+      // setup
+      CommandList saved;
+      CommandList loaded;
+      Position points[2] = { pixels(1.0, 2.0), pixels(-3.0, 4.0) };
+      unsigned char phases[2] = { 7, 200 };
+      saved.stars(points, phases, 2);
+      saved.text(pixels(-50.0, 40.0), "Orbital", 7);
+      stringstream stream;
+
+      // exercise
+      bool wrote = saved.save(stream);
+      bool read = loaded.load(stream);
+
+      // verify
+      assert(wrote && read);
+      assert(loaded.count() == 2);
+      assert(loaded.bytes == saved.bytes);
+      assert(loaded.compare(saved) == 2);
+   }  // teardown
+};
@@ -0,0 +1,255 @@
+/***********************************************************************
+ * Header File:
+ *    Test Conjunction : The test suite for conjunction screening
+ * Authors:
+ *    Emilio Regino, Bradley Payne
+ * Summary:
+ *    All the unit tests for the conjunction screener
+ ************************************************************************/
+
+#pragma once
+
+#include "conjunction.h"   // for CONJUNCTION SCREENER
+#include <cassert>         // for ASSERT
+#include <iostream>        // for COUT
+#include <list>            // for LIST
+using namespace std;
+
+/*******************************
+ * TEST CONJUNCTION
+ * A friend class for ConjunctionScreener which contains its unit tests
+ ********************************/
+class TestConjunction
+{
+public:
+   void run()
+   {
+      cout << "Conjunction: ";
+      test_elements_circular();
+      test_propagate_quarterOrbit();
+      test_filterApogeePerigee_apart();
+      test_filterApogeePerigee_overlap();
+      test_filterOrbitPath_nested();
+      test_filterTime_outOfStep();
+      test_screen_headOn();
+      test_screen_differentShells();
+      test_screen_nested();
+      test_screen_outOfStep();
+      cout << "Passed\n";
+   }
+
+private:
+   // utility funciton because floating point numbers are approximations
+   bool closeEnough(double value, double test, double tolerence) const
+   {
+      double difference = value - test;
+      return (difference >= -tolerence) && (difference <= tolerence);
+   }
+
+   // speed of a circular orbit at a given radius
+   double circularSpeed(double radius) const
+   {
+      return sqrt(-GRAVITY * EARTH_RADIUS * EARTH_RADIUS / radius);
+   }
+
+   // speed at perigee of an orbit reaching from rp out to ra
+   double perigeeSpeed(double rp, double ra) const
+   {
+      return sqrt(-GRAVITY * EARTH_RADIUS * EARTH_RADIUS * 2.0 * ra / (rp * (rp + ra)));
+   }
+
+   // a circular orbit has no eccentricity and a semi-major axis of its radius
+   void test_elements_circular()
+   {
+      // setup
+      double r = 26560000.0;
+      GPS gps(Position(r, 0.0), Velocity(0.0, circularSpeed(r)));
+
+      // exercise
+      ConjunctionScreener::Orbit orbit = ConjunctionScreener::elements(gps);
+
+      // verify
+      assert(orbit.bound);
+      assert(orbit.e < 1e-9);
+      assert(closeEnough(orbit.a, r, 1.0));
+      assert(orbit.direction == 1.0);
+   }  // teardown
+
+   // a quarter orbit counter-clockwise from the +x axis ends on the +y axis
+   void test_propagate_quarterOrbit()
+   {
+      // setup
+      double r = 26560000.0;
+      GPS gps(Position(r, 0.0), Velocity(0.0, circularSpeed(r)));
+      ConjunctionScreener::Orbit orbit = ConjunctionScreener::elements(gps);
+      double x;
+      double y;
+
+      // exercise
+      ConjunctionScreener::propagate(orbit, ConjunctionScreener::period(orbit) / 4.0, x, y);
+
+      // verify
+      assert(closeEnough(x, 0.0, 1.0));
+      assert(closeEnough(y, r,   1.0));
+   }  // teardown
+
+   // a low orbit and a geosynchronous one can never meet
+   void test_filterApogeePerigee_apart()
+   {
+      // setup
+      ConjunctionScreener screener(86400.0, 10000.0);
+      GPS low (Position( 7000000.0, 0.0), Velocity(0.0, circularSpeed( 7000000.0)));
+      GPS high(Position(42164000.0, 0.0), Velocity(0.0, circularSpeed(42164000.0)));
+
+      // exercise
+      bool pass = screener.filterApogeePerigee(ConjunctionScreener::elements(low),
+                                               ConjunctionScreener::elements(high));
+
+      // verify
+      assert(!pass);
+   }  // teardown
+
+   // two orbits at nearly the same altitude might
+   void test_filterApogeePerigee_overlap()
+   {
+      // setup
+      ConjunctionScreener screener(86400.0, 10000.0);
+      GPS gps1(Position(26560000.0, 0.0), Velocity(0.0, circularSpeed(26560000.0)));
+      GPS gps2(Position(26565000.0, 0.0), Velocity(0.0, circularSpeed(26565000.0)));
+
+      // exercise
+      bool pass = screener.filterApogeePerigee(ConjunctionScreener::elements(gps1),
+                                               ConjunctionScreener::elements(gps2));
+
+      // verify
+      assert(pass);
+   }  // teardown
+
+   // one ellipse inside another, perigees the same way: their altitudes
+   // overlap, but the curves stay 100km apart all the way around
+   void test_filterOrbitPath_nested()
+   {
+      // setup
+      ConjunctionScreener screener(86400.0, 10000.0);
+      GPS outer(Position(7000000.0, 0.0), Velocity(0.0, perigeeSpeed(7000000.0, 8000000.0)));
+      GPS inner(Position(6900000.0, 0.0), Velocity(0.0, perigeeSpeed(6900000.0, 7700000.0)));
+      ConjunctionScreener::Orbit orbit1 = ConjunctionScreener::elements(outer);
+      ConjunctionScreener::Orbit orbit2 = ConjunctionScreener::elements(inner);
+      vector<ConjunctionScreener::Window> directions;
+
+      // exercise
+      bool pass = screener.filterOrbitPath(orbit1, orbit2, directions);
+
+      // verify
+      assert(screener.filterApogeePerigee(orbit1, orbit2));
+      assert(!pass);
+      assert(directions.empty());
+   }  // teardown
+
+   // a circle crossing an ellipse of the same period, both starting
+   // from +x: the ellipse is always about two minutes off the circle at
+   // either crossing, so they are never there together
+   void test_filterTime_outOfStep()
+   {
+      // setup
+      ConjunctionScreener screener(86400.0, 10000.0);
+      GPS circle (Position(7500000.0, 0.0), Velocity(0.0, circularSpeed(7500000.0)));
+      GPS ellipse(Position(7000000.0, 0.0), Velocity(0.0, perigeeSpeed(7000000.0, 8000000.0)));
+      ConjunctionScreener::Orbit orbit1 = ConjunctionScreener::elements(circle);
+      ConjunctionScreener::Orbit orbit2 = ConjunctionScreener::elements(ellipse);
+      vector<ConjunctionScreener::Window> directions;
+      vector<ConjunctionScreener::Window> times;
+      bool crosses = screener.filterOrbitPath(orbit1, orbit2, directions);
+
+      // exercise
+      bool pass = screener.filterTime(orbit1, orbit2, directions, times);
+
+      // verify
+      assert(crosses);
+      assert(directions.size() == 2);
+      assert(!pass);
+      assert(times.empty());
+   }  // teardown
+
+   // two satellites going opposite ways around the same circle meet a
+   // quarter orbit later
+   void test_screen_headOn()
+   {
+      // setup
+      double r = 26560000.0;
+      double v = circularSpeed(r);
+      GPS prograde  (Position( r, 0.0), Velocity(0.0, v));
+      GPS retrograde(Position(-r, 0.0), Velocity(0.0, v));
+      list<Satellite *> satellites = { &prograde, &retrograde };
+      double T = 2.0 * M_PI * r / v;
+      ConjunctionScreener screener(T / 2.0, 10000.0);
+
+      // exercise
+      vector<Conjunction> conjunctions = screener.screen(satellites);
+
+      // verify
+      assert(conjunctions.size() == 1);
+      assert(closeEnough(conjunctions[0].tca, T / 4.0, 1.0));
+      assert(conjunctions[0].missDistance < 100.0);
+      assert(screener.getStats().pairs == 1);
+      assert(screener.getStats().orbitPath == 1);
+      assert(screener.getStats().time == 1);
+      assert(screener.getStats().encounters == 1);
+   }  // teardown
+
+   // satellites in different shells are thrown out by the first filter
+   void test_screen_differentShells()
+   {
+      // setup
+      GPS low (Position( 7000000.0, 0.0), Velocity(0.0, circularSpeed( 7000000.0)));
+      GPS high(Position(42164000.0, 0.0), Velocity(0.0, circularSpeed(42164000.0)));
+      list<Satellite *> satellites = { &low, &high };
+      ConjunctionScreener screener(86400.0, 10000.0);
+
+      // exercise
+      vector<Conjunction> conjunctions = screener.screen(satellites);
+
+      // verify
+      assert(conjunctions.empty());
+      assert(screener.getStats().pairs == 1);
+      assert(screener.getStats().apogeePerigee == 0);
+   }  // teardown
+
+   // nested ellipses get past the first filter but not the second
+   void test_screen_nested()
+   {
+      // setup
+      GPS outer(Position(7000000.0, 0.0), Velocity(0.0, perigeeSpeed(7000000.0, 8000000.0)));
+      GPS inner(Position(6900000.0, 0.0), Velocity(0.0, perigeeSpeed(6900000.0, 7700000.0)));
+      list<Satellite *> satellites = { &outer, &inner };
+      ConjunctionScreener screener(86400.0, 10000.0);
+
+      // exercise
+      vector<Conjunction> conjunctions = screener.screen(satellites);
+
+      // verify
+      assert(conjunctions.empty());
+      assert(screener.getStats().apogeePerigee == 1);
+      assert(screener.getStats().orbitPath == 0);
+   }  // teardown
+
+   // orbits that cross out of step get past the second filter but not
+   // the third
+   void test_screen_outOfStep()
+   {
+      // setup
+      GPS circle (Position(7500000.0, 0.0), Velocity(0.0, circularSpeed(7500000.0)));
+      GPS ellipse(Position(7000000.0, 0.0), Velocity(0.0, perigeeSpeed(7000000.0, 8000000.0)));
+      list<Satellite *> satellites = { &circle, &ellipse };
+      ConjunctionScreener screener(86400.0, 10000.0);
+
+      // exercise
+      vector<Conjunction> conjunctions = screener.screen(satellites);
+
+      // verify
+      assert(conjunctions.empty());
+      assert(screener.getStats().orbitPath == 1);
+      assert(screener.getStats().time == 0);
+      assert(screener.getStats().encounters == 0);
+   }  // teardown
+};
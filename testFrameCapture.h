@@ -0,0 +1,140 @@
+/***********************************************************************
+ * Header File:
+ *    Test Frame Capture : The test suite for recording frames
+ * Authors:
+ *    Emilio Regino, Bradley Payne
+ * Summary:
+ *    All the unit tests for FrameCapture. They write small files next
+ *    to the program and remove them afterward.
+ ************************************************************************/
+
+#pragma once
+
+#include "frameCapture.h"   // for FRAME CAPTURE
+#include <fstream>          // for IFSTREAM
+#include <iterator>         // for ISTREAMBUF_ITERATOR
+#include <cstdio>           // for REMOVE
+#include <cassert>          // for ASSERT
+#include <iostream>         // for COUT
+using namespace std;
+
+/*******************************
+ * TEST FRAME CAPTURE
+ * A friend class for FrameCapture which contains its unit tests
+ ********************************/
+class TestFrameCapture
+{
+public:
+   void run()
+   {
+      cout << "Frame Capture: ";
+      test_y4m_everyFrame();
+      test_ppm_topRowFirst();
+      test_renderer_capturesFrame();
+      cout << "Passed\n";
+   }
+
+private:
+   static string readFile(const char * path)
+   {
+      ifstream in(path, ios::binary);
+      return string(istreambuf_iterator<char>(in), istreambuf_iterator<char>());
+   }
+
+   // more frames than the queue holds all arrive, in order, as Y then
+   // U then V
+   void test_y4m_everyFrame()
+   {
+      // setup
+      const char * path = "testFrameCapture.y4m";
+      unsigned char white[4 * 2 * 4];
+      unsigned char black[4 * 2 * 4] = {};
+      for (int i = 0; i < 4 * 2 * 4; i++)
+         white[i] = 255;
+
+      // exercise
+      {
+         FrameCapture capture(path, CAPTURE_Y4M, 4, 2, 30, 2);
+         for (int i = 0; i < 5; i++)
+            capture.capture(i % 2 ? black : white, false /*bottomUp*/);
+      }
+
+      // verify
+      string file = readFile(path);
+      string header = "YUV4MPEG2 W4 H2 F30:1 Ip A1:1 C420jpeg\n";
+      size_t frame = 6 + 4 * 2 + 2 * 2;   // FRAME\n, Y, U, and V
+      assert(file.compare(0, header.size(), header) == 0);
+      assert(file.size() == header.size() + 5 * frame);
+      for (int i = 0; i < 5; i++)
+      {
+         size_t at = header.size() + i * frame;
+         assert(file.compare(at, 6, "FRAME\n") == 0);
+         assert((unsigned char)file[at + 6] == (i % 2 ? 0 : 255));     // Y
+         assert((unsigned char)file[at + 6 + 8] == 128);               // U
+         assert((unsigned char)file[at + 6 + 11] == 128);              // V
+      }
+
+      // teardown
+      remove(path);
+   }
+
+   // a frame read back from OpenGL, bottom row first, is written the
+   // right way up
+   void test_ppm_topRowFirst()
+   {
+      // setup
+      unsigned char rgba[2 * 4] =
+      {
+         255, 0, 0, 255,   // the bottom row: red
+         0, 0, 255, 255    // the top row: blue
+      };
+
+      FrameCapture capture("testFrameCapture", CAPTURE_PPM, 1, 2);
+
+      // exercise
+      capture.capture(rgba, true /*bottomUp*/);
+      capture.capture(rgba, false /*bottomUp*/);
+      capture.finish();
+
+      // verify
+      assert(capture.getWritten() == 2);
+      assert(capture.good());
+      string first = readFile("testFrameCapture000000.ppm");
+      string second = readFile("testFrameCapture000001.ppm");
+      assert(first == string("P6\n1 2\n255\n\x00\x00\xff\xff\x00\x00", 17));
+      assert(second == string("P6\n1 2\n255\n\xff\x00\x00\x00\x00\xff", 17));
+
+      // teardown
+      remove("testFrameCapture000000.ppm");
+      remove("testFrameCapture000001.ppm");
+   }
+
+   // every frame a capture renderer draws is handed to its capture, as
+   // drawn. Read back from the window it is the same but for the
+   // renderer, which needs a window the tests do not have.
+   void test_renderer_capturesFrame()
+   {
+      // setup
+      Frame frame;
+      frame.points.push_back({ -0.5f, 0.5f, { 0, 255, 0, 255 } });   // top left
+
+      // exercise: the capture writes what is queued before it goes
+      {
+         FrameCapture capture("testFrameCapture", CAPTURE_PPM, 2, 2);
+         CaptureRenderer renderer(capture, CAPTURE_OFFSCREEN);
+         renderer.render(frame);
+         renderer.render(Frame());
+      }
+
+      // verify
+      string first = readFile("testFrameCapture000000.ppm");
+      string second = readFile("testFrameCapture000001.ppm");
+      assert(first == string("P6\n2 2\n255\n\x00\xff\x00" "\x00\x00\x00"
+                             "\x00\x00\x00" "\x00\x00\x00", 23));
+      assert(second == string("P6\n2 2\n255\n", 11) + string(12, '\0'));
+
+      // teardown
+      remove("testFrameCapture000000.ppm");
+      remove("testFrameCapture000001.ppm");
+   }
+};
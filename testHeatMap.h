@@ -0,0 +1,121 @@
+/***********************************************************************
+ * Header File:
+ *    Test Heat Map : The test suite for the heat map
+ * Authors:
+ *    Emilio Regino, Bradley Payne
+ * Summary:
+ *    All the unit tests for counting satellites into pixels and
+ *    turning the counts into levels
+ ************************************************************************/
+
+#pragma once
+
+#include "heatMap.h"    // for HEAT MAP
+#include "position.h"   // for POSITION
+#include <cassert>      // for ASSERT
+#include <iostream>     // for COUT
+using namespace std;
+
+/*******************************
+ * TEST HEAT MAP
+ * A friend class for HeatMap which contains its unit tests
+ ********************************/
+class TestHeatMap
+{
+public:
+   void run()
+   {
+      cout << "Heat Map: ";
+      test_splat_countsByPixel();
+      test_splat_sharedSameAsAlone();
+      test_toneMap_levels();
+      cout << "Passed\n";
+   }
+
+private:
+   // one satellite at a given spot, in meters, whose last step was still
+   static SatelliteState at(Kind kind, double x, double y)
+   {
+      SatelliteState state = {};
+      state.kind = kind;
+      state.x = state.lastX = x;
+      state.y = state.lastY = y;
+      return state;
+   }
+
+   // everything but the ship lands in the pixel under it, and nothing
+   // off the grid lands at all
+   void test_splat_countsByPixel()
+   {
+      // setup
+      double zoom = Position().getZoom();
+      HeatMap heatMap(4, 4, 1);
+      std::vector<SatelliteState> satellites =
+      {
+         at(KIND_FRAGMENT,  0.5 * zoom,  0.5 * zoom),   // column 2, row 1
+         at(KIND_FRAGMENT,  0.5 * zoom,  0.5 * zoom),
+         at(KIND_SPUTNIK,  -1.5 * zoom, -1.5 * zoom),   // column 0, row 3
+         at(KIND_SHIP,      0.5 * zoom,  0.5 * zoom),
+         at(KIND_FRAGMENT,  9.0 * zoom,  0.0)           // off the grid
+      };
+
+      // exercise
+      size_t landed = heatMap.splat(satellites, 1.0);
+
+      // verify
+      assert(landed == 3);
+      assert(heatMap.counts[1 * 4 + 2].load() == 2);
+      assert(heatMap.counts[3 * 4 + 0].load() == 1);
+      assert(heatMap.counts[0].load() == 0);
+   }  // teardown
+
+   // enough satellites to be split across workers are counted into the
+   // shared grid exactly as one worker counts them, even with several
+   // piling into the same pixels at once
+   void test_splat_sharedSameAsAlone()
+   {
+      // setup
+      double zoom = Position().getZoom();
+      HeatMap alone(8, 8, 1);
+      HeatMap shared(8, 8, 4);
+      std::vector<SatelliteState> satellites;
+      for (int i = 0; i < 3 * 4096; i++)
+         satellites.push_back(at(i % 11 == 0 ? KIND_SHIP : KIND_FRAGMENT,
+                                 (i % 5 - 2.5) * zoom,
+                                 (i % 13 - 6.5) * zoom));
+
+      // exercise
+      size_t landedAlone  = alone.splat(satellites, 1.0);
+      size_t landedShared = shared.splat(satellites, 1.0);
+
+      // verify
+      assert(landedShared == landedAlone);
+      assert(landedAlone > 0 && landedAlone < satellites.size());
+      for (int i = 0; i < 8 * 8; i++)
+         assert(shared.counts[i].load() == alone.counts[i].load());
+   }  // teardown
+
+   // empty is 0, the most crowded 255, and the rest in between; the
+   // counts start over afterward
+   void test_toneMap_levels()
+   {
+      // setup
+      HeatMap heatMap(2, 2, 1);
+      heatMap.splat(std::vector<SatelliteState>(), 1.0);
+      heatMap.counts[0].store(100);
+      heatMap.counts[1].store(10);
+      heatMap.counts[3].store(1);
+
+      // exercise
+      heatMap.toneMap();
+
+      // verify
+      assert(heatMap.levels[0] == 255);
+      assert(heatMap.levels[1] > heatMap.levels[3]);
+      assert(heatMap.levels[1] < 255);
+      assert(heatMap.levels[2] == 0);
+      assert(heatMap.levels[3] == 1);
+      for (int i = 0; i < 4; i++)
+         assert(heatMap.counts[i].load() == 0);
+   }  // teardown
+};
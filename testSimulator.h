@@ -0,0 +1,75 @@
+/***********************************************************************
+ * Header File:
+ *    Test Simulator : The test suite for the simulator
+ * Authors:
+ *    Emilio Regino, Bradley Payne
+ * Summary:
+ *    All the unit tests for what the simulator draws each frame
+ ************************************************************************/
+
+#pragma once
+
+#include "simulator.h"   // for SIMULATOR
+#include "renderer.h"    // for RENDERER
+#include "uiDraw.h"      // for SET RENDERER
+#include "position.h"    // for POSITION
+#include <cassert>       // for ASSERT
+#include <iostream>      // for COUT
+#include <vector>        // for VECTOR
+using namespace std;
+
+/*******************************
+ * TEST SIMULATOR
+ * Contains the unit tests for the simulator
+ ********************************/
+class TestSimulator
+{
+public:
+   void run()
+   {
+      cout << "Simulator: ";
+      test_draw_statsOnScreen();
+      cout << "Passed\n";
+   }
+
+private:
+   // keeps the text of the frame it was handed
+   class TextRenderer : public Renderer
+   {
+   public:
+      void render(const Frame & frame) { texts = frame.texts; }
+      vector<Text> texts;
+   };
+
+   // the render stats start in the top left corner of the window, not
+   // past it; the window is 1000 pixels across, so 500 either side
+   void test_draw_statsOnScreen()
+   {
+      // setup
+      Position ptUpperRight;
+      ptUpperRight.setPixelsX(1000.0);
+      ptUpperRight.setPixelsY(1000.0);
+      Simulator simulator(ptUpperRight);
+      simulator.setShowStats(true);
+      TextRenderer renderer;
+      setRenderer(&renderer);
+
+      // exercise
+      simulator.draw();
+      simulator.update();
+      simulator.draw();
+      setRenderer(NULL);
+
+      // verify
+      assert(renderer.texts.empty() == !RENDER_STATS);
+      if (renderer.texts.empty())
+         return;
+      assert(renderer.texts.front().x == (float)(-500.0 + STATS_MARGIN));
+      assert(renderer.texts.front().y == (float)(500.0 - STATS_MARGIN));
+      for (const Text & text : renderer.texts)
+      {
+         assert(text.x > -500.0f && text.x < 0.0f);
+         assert(text.y > 0.0f && text.y < 500.0f);
+      }
+   }  // teardown
+};
@@ -0,0 +1,136 @@
+/***********************************************************************
+ * Header File:
+ *    Test Software Renderer : The test suite for the software renderer
+ * Authors:
+ *    Emilio Regino, Bradley Payne
+ * Summary:
+ *    All the unit tests for drawing frames into memory
+ ************************************************************************/
+
+#pragma once
+
+#include "softwareRenderer.h"  // for SOFTWARE RENDERER
+#include <cassert>             // for ASSERT
+#include <iostream>            // for COUT
+using namespace std;
+
+/*******************************
+ * TEST SOFTWARE RENDERER
+ * A friend class for SoftwareRenderer which contains its unit tests
+ ********************************/
+class TestSoftwareRenderer
+{
+public:
+   void run()
+   {
+      cout << "Software Renderer: ";
+      test_render_point();
+      test_render_squareCoveredOnce();
+      test_render_clearsLastFrame();
+      test_render_sameForAnyWorkers();
+      cout << "Passed\n";
+   }
+
+private:
+   const unsigned char * pixel(const SoftwareRenderer & renderer, int x, int y)
+   {
+      return &renderer.pixels[((size_t)y * renderer.width + x) * 4];
+   }
+
+   int count(const SoftwareRenderer & renderer, unsigned char red)
+   {
+      int num = 0;
+      for (int y = 0; y < renderer.height; y++)
+         for (int x = 0; x < renderer.width; x++)
+            if (pixel(renderer, x, y)[0] == red)
+               num++;
+      return num;
+   }
+
+   // a point at the center of the screen lands just right and below it
+   void test_render_point()
+   {
+      // setup
+      SoftwareRenderer renderer(8, 8);
+      Frame frame;
+      frame.points.push_back({ 0.5f, -0.5f, { 200, 0, 0, 255 } });
+
+      // exercise
+      renderer.render(frame);
+
+      // verify
+      assert(pixel(renderer, 4, 4)[0] == 200);
+      assert(count(renderer, 200) == 1);
+   }  // teardown
+
+   // two triangles sharing a diagonal color each pixel of the square once
+   void test_render_squareCoveredOnce()
+   {
+      // setup
+      SoftwareRenderer renderer(8, 8);
+      Frame frame;
+      frame.triangles.push_back({ -2.0f, -2.0f, { 100, 0, 0, 255 } });
+      frame.triangles.push_back({ -2.0f,  2.0f, { 100, 0, 0, 255 } });
+      frame.triangles.push_back({  2.0f,  2.0f, { 100, 0, 0, 255 } });
+      frame.triangles.push_back({ -2.0f, -2.0f, { 150, 0, 0, 255 } });
+      frame.triangles.push_back({  2.0f,  2.0f, { 150, 0, 0, 255 } });
+      frame.triangles.push_back({  2.0f, -2.0f, { 150, 0, 0, 255 } });
+
+      // exercise
+      renderer.render(frame);
+
+      // verify
+      int first = count(renderer, 100);
+      int second = count(renderer, 150);
+      assert(first + second == 16);
+      assert(first == 10 || second == 10);   // the diagonal went to one
+      assert(pixel(renderer, 1, 1)[0] == 0);
+   }  // teardown
+
+   // nothing from the last frame survives into the next
+   void test_render_clearsLastFrame()
+   {
+      // setup
+      SoftwareRenderer renderer(8, 8);
+      Frame frame;
+      frame.points.push_back({ 0.5f, -0.5f, { 200, 0, 0, 255 } });
+      renderer.render(frame);
+      frame.clear();
+
+      // exercise
+      renderer.render(frame);
+
+      // verify
+      assert(count(renderer, 0) == 64);
+      assert(pixel(renderer, 4, 4)[3] == 255);
+   }  // teardown
+
+   // shapes crossing tile corners come out the same on one thread or four
+   void test_render_sameForAnyWorkers()
+   {
+      // setup
+      SoftwareRenderer serial(200, 150, 1);
+      SoftwareRenderer threaded(200, 150, 4);
+      Frame frame;
+      for (int i = 0; i < 40; i++)
+      {
+         float x = (float)(i * 37 % 190) - 95.0f;
+         float y = (float)(i * 53 % 140) - 70.0f;
+         unsigned char shade = (unsigned char)(i * 6);
+         frame.triangles.push_back({ x,         y,         { shade, 100, 0, 255 } });
+         frame.triangles.push_back({ x + 70.3f, y + 5.7f,  { shade, 100, 0, 255 } });
+         frame.triangles.push_back({ x + 20.1f, y - 66.9f, { shade, 100, 0, 255 } });
+         frame.lines.push_back({ -x, y,        { 0, shade, 200, 255 } });
+         frame.lines.push_back({ x,  -y * 0.5f, { 0, shade, 200, 255 } });
+         frame.points.push_back({ y, x * 0.7f, { 255, 255, shade, 255 } });
+      }
+
+      // exercise
+      serial.render(frame);
+      threaded.render(frame);
+
+      // verify
+      assert(serial.pixels == threaded.pixels);
+      assert(count(serial, 0) < 200 * 150);   // something was drawn
+   }  // teardown
+};
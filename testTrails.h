@@ -0,0 +1,127 @@
+/***********************************************************************
+ * Header File:
+ *    Test Trails : The test suite for the orbit trails
+ * Authors:
+ *    Emilio Regino, Bradley Payne
+ * Summary:
+ *    All the unit tests for the ring buffers behind the orbit trails
+ ************************************************************************/
+
+#pragma once
+
+#include "trail.h"      // for TRAILS
+#include "renderer.h"   // for RENDERER
+#include "uiDraw.h"     // for DRAW FLUSH
+#include "position.h"   // for POSITION
+#include <cassert>      // for ASSERT
+#include <iostream>     // for COUT
+using namespace std;
+
+/*******************************
+ * TEST TRAILS
+ * A friend class for Trails which contains its unit tests
+ ********************************/
+class TestTrails
+{
+public:
+   void run()
+   {
+      cout << "Trails: ";
+      test_record_keepsNewest();
+      test_record_overBudget();
+      test_release_reused();
+      test_draw_endsWithSatellite();
+      cout << "Passed\n";
+   }
+
+private:
+   // once a ring is full the oldest position is the one written over
+   void test_record_keepsNewest()
+   {
+      // setup
+      Trails trails(3, 1);
+
+      // exercise
+      for (int i = 1; i <= 4; i++)
+         trails.record(7, i * 100.0, -i * 100.0);
+
+      // verify
+      const TrailSlot & ring = trails.slots[0];
+      assert(ring.id == 7);
+      assert(ring.count == 3);
+      assert(ring.head == 1);
+      assert(trails.points[0] == 400.0f);   // the fourth overwrote the first
+      assert(trails.points[1] == -400.0f);
+      assert(trails.points[2] == 200.0f);
+      assert(trails.points[4] == 300.0f);
+   }  // teardown
+
+   // past the budget a newcomer gets no trail and nobody loses theirs
+   void test_record_overBudget()
+   {
+      // setup
+      Trails trails(4, 2);
+      trails.record(1, 0.0, 0.0);
+      trails.record(2, 0.0, 0.0);
+
+      // exercise
+      trails.record(3, 0.0, 0.0);
+
+      // verify
+      assert(trails.getTracked() == 2);
+      assert(trails.index.count(3) == 0);
+      assert(trails.slots[trails.index[1]].count == 1);
+      assert(trails.slots[trails.index[2]].count == 1);
+   }  // teardown
+
+   // a released ring starts over empty for the next satellite
+   void test_release_reused()
+   {
+      // setup
+      Trails trails(4, 1);
+      trails.record(1, 10.0, 10.0);
+      trails.record(1, 20.0, 20.0);
+
+      // exercise
+      trails.release(1);
+      trails.record(2, 30.0, 30.0);
+
+      // verify
+      assert(trails.getTracked() == 1);
+      assert(trails.slots[0].id == 2);
+      assert(trails.slots[0].count == 1);
+      assert(trails.points[0] == 30.0f);
+   }  // teardown
+
+   // keeps the trails of the frame it was handed
+   class TrailRenderer : public Renderer
+   {
+   public:
+      void render(const Frame & frame) { trails = frame.trails; }
+      std::vector<Vertex> trails;
+   };
+
+   // drawn partway through a step, a trail ends where its satellite is
+   // drawn, not where the satellite will be after the step
+   void test_draw_endsWithSatellite()
+   {
+      // setup
+      Trails trails(4, 1);
+      trails.record(1, 0.0, 0.0);
+      trails.record(1, 1000000.0, 0.0);
+      trails.record(1, 3000000.0, 2000000.0);
+      TrailRenderer renderer;
+      setRenderer(&renderer);
+
+      // exercise
+      trails.draw(0.25);
+      drawFlush();
+      setRenderer(NULL);
+
+      // verify
+      Position between(1500000.0, 500000.0);
+      assert(renderer.trails.size() == 2 * 2);
+      assert(renderer.trails.back().x == (float)between.getPixelsX());
+      assert(renderer.trails.back().y == (float)between.getPixelsY());
+   }  // teardown
+};
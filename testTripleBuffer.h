@@ -0,0 +1,100 @@
+/***********************************************************************
+ * Header File:
+ *    Test Triple Buffer : The test suite for the triple buffer
+ * Authors:
+ *    Emilio Regino, Bradley Payne
+ * Summary:
+ *    All the unit tests for handing values between threads
+ ************************************************************************/
+
+#pragma once
+
+#include "tripleBuffer.h"   // for TRIPLE BUFFER
+#include <thread>           // for THREAD
+#include <cassert>          // for ASSERT
+#include <iostream>         // for COUT
+using namespace std;
+
+/*******************************
+ * TEST TRIPLE BUFFER
+ * A friend class for TripleBuffer which contains its unit tests
+ ********************************/
+class TestTripleBuffer
+{
+public:
+   void run()
+   {
+      cout << "Triple Buffer: ";
+      test_latest_newestWins();
+      test_latest_keepsWithoutPublish();
+      test_threads_neverTorn();
+      cout << "Passed\n";
+   }
+
+private:
+   // of two publishes before a read, the reader sees the second
+   void test_latest_newestWins()
+   {
+      // setup
+      TripleBuffer<int> buffer;
+      buffer.back() = 1;
+      buffer.publish();
+      buffer.back() = 2;
+      buffer.publish();
+
+      // exercise
+      int value = buffer.latest();
+
+      // verify
+      assert(value == 2);
+   }  // teardown
+
+   // with nothing new the reader keeps what it had, even while the
+   // writer is partway through the next one
+   void test_latest_keepsWithoutPublish()
+   {
+      // setup
+      TripleBuffer<int> buffer;
+      buffer.back() = 7;
+      buffer.publish();
+      buffer.latest();
+      buffer.back() = 8;
+
+      // exercise
+      int value = buffer.latest();
+
+      // verify
+      assert(value == 7);
+   }  // teardown
+
+   // a reader on another thread only ever sees whole values, in order
+   void test_threads_neverTorn()
+   {
+      // setup
+      struct Pair { int a; int b; };
+      TripleBuffer<Pair> buffer;
+      buffer.back() = { 0, 0 };
+      buffer.publish();
+
+      // exercise
+      std::thread writer([&buffer]()
+      {
+         for (int i = 1; i <= 20000; i++)
+         {
+            buffer.back() = { i, -i };
+            buffer.publish();
+         }
+      });
+      int last = 0;
+      while (last < 20000)
+      {
+         Pair pair = buffer.latest();
+
+         // verify
+         assert(pair.a == -pair.b);
+         assert(pair.a >= last);
+         last = pair.a;
+      }
+      writer.join();
+   }  // teardown
+};
@@ -0,0 +1,128 @@
+/***********************************************************************
+ * Source File:
+ *    Trails : Where the satellites have been lately
+ * Author:
+ *    Emilio Regino, Bradley Payne, Penelope Sanchez
+ * Summary:
+ *    Positions are kept as floats, good to a few meters out past the
+ *    GPS satellites and far finer than a pixel at any zoom we use. Each
+ *    ring is unrolled oldest first when it is drawn.
+ ************************************************************************/
+
+#include "trail.h"      // for TRAILS
+#include "uiDraw.h"     // for DRAW TRAIL
+#include "position.h"   // for POSITION
+#include <algorithm>    // for MIN
+
+/*************************************************************************
+ * RESIZE
+ * Set aside the whole block now, so recording never has to
+ *************************************************************************/
+void Trails :: resize(size_t length, size_t budget)
+{
+   this->length = length;
+   this->budget = budget;
+   points.assign(length * budget * 2, 0.0f);
+   slots.assign(budget, { 0, 0, 0 });
+
+   // hand out the low rings first
+   freeSlots.clear();
+   freeSlots.reserve(budget);
+   for (size_t slot = budget; slot > 0; slot--)
+      freeSlots.push_back((unsigned int)(slot - 1));
+
+   index.clear();
+   index.reserve(budget);
+}
+
+/*************************************************************************
+ * RECORD
+ * A satellite seen for the first time takes a free ring, if there is one
+ *************************************************************************/
+void Trails :: record(unsigned int id, double x, double y)
+{
+   if (!isEnabled())
+      return;
+
+   unsigned int slot;
+   auto it = index.find(id);
+   if (it != index.end())
+      slot = it->second;
+   else
+   {
+      if (freeSlots.empty())
+         return;
+      slot = freeSlots.back();
+      freeSlots.pop_back();
+      index[id] = slot;
+      slots[slot] = { id, 0, 0 };
+   }
+
+   TrailSlot & ring = slots[slot];
+   float * point = &points[(slot * length + ring.head) * 2];
+   point[0] = (float)x;
+   point[1] = (float)y;
+   ring.head = (unsigned int)((ring.head + 1) % length);
+   ring.count = (unsigned int)std::min((size_t)ring.count + 1, length);
+}
+
+/*************************************************************************
+ * RELEASE
+ *************************************************************************/
+void Trails :: release(unsigned int id)
+{
+   auto it = index.find(id);
+   if (it == index.end())
+      return;
+   slots[it->second].count = 0;
+   freeSlots.push_back(it->second);
+   index.erase(it);
+}
+
+/*************************************************************************
+ * COPY INTO
+ * Everything draw() needs. The index from id to ring is left behind: it
+ * is only for recording, and copying it would allocate every time.
+ *************************************************************************/
+void Trails :: copyInto(Trails & rhs) const
+{
+   rhs.length = length;
+   rhs.budget = budget;
+   rhs.points = points;
+   rhs.slots = slots;
+   rhs.freeSlots = freeSlots;
+}
+
+/*************************************************************************
+ * DRAW
+ * Each trail oldest first, as one strip. Every step adds a position, so
+ * the last two are where the satellite was one step ago and is now.
+ *************************************************************************/
+void Trails :: draw(double fraction) const
+{
+   // reused from one frame to the next
+   static std::vector<Position> strip;
+
+   for (size_t slot = 0; slot < slots.size(); slot++)
+   {
+      const TrailSlot & ring = slots[slot];
+      if (ring.count < 2)
+         continue;
+
+      strip.resize(ring.count);
+      size_t at = (ring.head + length - ring.count) % length;
+      for (size_t i = 0; i < ring.count; i++, at = (at + 1) % length)
+      {
+         const float * point = &points[(slot * length + at) * 2];
+         strip[i].setMeters(point[0], point[1]);
+      }
+      if (fraction < 1.0)
+      {
+         const Position & last = strip[ring.count - 2];
+         Position & newest = strip[ring.count - 1];
+         newest.setMeters(last.getMetersX() + (newest.getMetersX() - last.getMetersX()) * fraction,
+                          last.getMetersY() + (newest.getMetersY() - last.getMetersY()) * fraction);
+      }
+      drawTrail(strip.data(), strip.size());
+   }
+}
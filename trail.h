@@ -0,0 +1,74 @@
+/***********************************************************************
+ * Header File:
+ *    Trails : Where the satellites have been lately
+ * Author:
+ *    Emilio Regino, Bradley Payne, Penelope Sanchez
+ * Summary:
+ *    Every tracked satellite gets a ring buffer of its last few
+ *    positions. The rings are all cut from one block allocated up front,
+ *    so recording a position never allocates, and the memory is fixed
+ *    by the length of a trail and how many satellites may have one.
+ *    Satellites beyond that budget simply have no trail.
+ ************************************************************************/
+
+#pragma once
+
+#include <vector>          // for VECTOR
+#include <unordered_map>   // for UNORDERED_MAP
+#include <cstddef>         // for SIZE_T
+
+class TestTrails;
+
+/************************************************************
+ * TRAIL SLOT
+ * One ring in the block, and whose it is
+ ************************************************************/
+struct TrailSlot
+{
+   unsigned int id;      // the satellite it belongs to
+   unsigned int head;    // where the next position goes
+   unsigned int count;   // how many positions it holds; 0 when free
+};
+
+/************************************************************
+ * TRAILS
+ * Ring buffers of recent positions, one per tracked satellite
+ ************************************************************/
+class Trails
+{
+public:
+   friend TestTrails;
+
+   Trails(size_t length = 0, size_t budget = 0) { resize(length, budget); }
+
+   // how many positions a trail keeps, and how many satellites get one.
+   // Forgets every trail.
+   void resize(size_t length, size_t budget);
+
+   // add a position, in meters, to the end of a satellite's trail
+   void record(unsigned int id, double x, double y);
+
+   // the satellite is gone: its ring goes to the next newcomer
+   void release(unsigned int id);
+
+   // copy the trails for drawing elsewhere, reusing the copy's memory
+   void copyInto(Trails & rhs) const;
+
+   // draw every trail, fading out toward its oldest end. The newest
+   // end is drawn the fraction of the way through the last step that
+   // the satellites are, so it stops where they do.
+   void draw(double fraction = 1.0) const;
+
+   bool isEnabled()   const { return length > 1 && budget > 0; }
+   size_t getLength() const { return length;                   }
+   size_t getBudget() const { return budget;                   }
+   size_t getTracked() const { return budget - freeSlots.size(); }
+
+private:
+   size_t length;                       // positions per trail
+   size_t budget;                       // most trails at once
+   std::vector<float> points;           // budget rings of length x, y pairs
+   std::vector<TrailSlot> slots;        // one per ring
+   std::vector<unsigned int> freeSlots; // rings nobody has
+   std::unordered_map<unsigned int, unsigned int> index;  // id to ring
+};
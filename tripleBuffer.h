@@ -0,0 +1,52 @@
+/***********************************************************************
+ * Header File:
+ *    Triple Buffer : Hand the newest value from one thread to another
+ * Author:
+ *    Emilio Regino, Bradley Payne, Penelope Sanchez
+ * Summary:
+ *    One thread writes, one thread reads, and neither ever waits. The
+ *    writer fills its own slot and swaps it into the middle; the reader
+ *    swaps the middle out whenever something new is there. The swaps
+ *    are one atomic exchange each, so there is no lock to hold.
+ ************************************************************************/
+
+#pragma once
+
+#include <atomic>     // for ATOMIC
+
+/************************************************************
+ * TRIPLE BUFFER
+ * Three copies of T: one being written, one being read, and
+ * the newest finished one waiting in between
+ ************************************************************/
+template <class T>
+class TripleBuffer
+{
+public:
+   TripleBuffer() : writing(0), middle(1), reading(2) {}
+
+   // the writer's slot; fill it in, then publish()
+   T & back() { return slots[writing]; }
+
+   // hand the writer's slot over as the newest
+   void publish()
+   {
+      writing = middle.exchange(writing | FRESH, std::memory_order_acq_rel) & ~FRESH;
+   }
+
+   // the newest published value; the reader's until the next call
+   const T & latest()
+   {
+      if (middle.load(std::memory_order_relaxed) & FRESH)
+         reading = middle.exchange(reading, std::memory_order_acq_rel) & ~FRESH;
+      return slots[reading];
+   }
+
+private:
+   static const int FRESH = 4;   // set on the middle when it is newer
+
+   T slots[3];
+   int writing;                  // only the writer touches this
+   std::atomic<int> middle;
+   int reading;                  // only the reader touches this
+};
@@ -12,145 +12,970 @@
 
 #include <string>     // need you ask?
 #include <sstream>    // convert an integer into text
+#include <vector>     // for the vertex batch
+#include <algorithm>  // for FIND_IF and MAX_ELEMENT
+#include <cstring>    // for MEMCPY
+#include <cstdint>    // for UINT32_T
 #include <cassert>    // I feel the need... the need for asserts
+#include <chrono>     // for STEADY_CLOCK
+#include <atomic>     // for ATOMIC
+#include <thread>     // for THIS_THREAD
+#include <iomanip>    // for SETPRECISION
 #include <time.h>     // for clock
 
-
-#ifdef __APPLE__
-#define GL_SILENCE_DEPRECATION
-#include <openGL/gl.h>    // Main OpenGL library
-#include <GLUT/glut.h>    // Second OpenGL library
-#endif // __APPLE__
-
-#ifdef __linux__
-#include <GL/gl.h>        // Main OpenGL library
-#include <GL/glut.h>      // Second OpenGL library
-#endif // __linux__
-
 #ifdef _WIN32
-#include <stdio.h>
-#include <stdlib.h>
-#include <GL/glut.h>         // OpenGL library we copied 
 #define _USE_MATH_DEFINES
 #include <math.h>
 #endif // _WIN32
 
 #include "position.h"
 #include "uiDraw.h"
+#include "renderer.h"     // for FRAME and RENDERER
+#include "glRenderer.h"   // for GL RENDERER
+#include "commandList.h"  // for COMMAND LIST
+#include "softwareRenderer.h"   // for SOFTWARE RENDERER, to make sprites
 
 using namespace std;
 
-// colors ueed in the simulator
-const int RGB_WHITE[] =      { 255, 255, 255 };
-const int RGB_LIGHT_GREY[] = { 196, 196, 196 };
-const int RGB_GREY[] =       { 128, 128, 128 };
-const int RGB_DARK_GREY[] =  { 64,   64,  64 };
-const int RGB_DEEP_BLUE[] =  { 64,   64, 156 };
-const int RGB_BLUE[] =       { 0,     0, 256 };
-const int RGB_RED[] =        { 255,   0,   0 };
-const int RGB_GOLD[] =       { 255, 255,   0 };
-const int RGB_TAN[] =        { 180, 150, 110 };
-const int RGB_GREEN[] =      {   0, 150,   0 };
+/************************************************************
+ * PALETTE COLOR
+ * The colors used in the simulator, by their place in the
+ * palette, so a color fits in a byte
+ ************************************************************/
+enum PaletteColor : unsigned char
+{
+   RGB_WHITE,
+   RGB_LIGHT_GREY,
+   RGB_GREY,
+   RGB_DARK_GREY,
+   RGB_DEEP_BLUE,
+   RGB_BLUE,
+   RGB_RED,
+   RGB_GOLD,
+   RGB_TAN,
+   RGB_GREEN
+};
+
+// each color already packed the way a vertex holds it, so setting one
+// is a 4 byte copy
+const unsigned char PALETTE[][4] =
+{
+   { 255, 255, 255, 255 },   // white
+   { 196, 196, 196, 255 },   // light grey
+   { 128, 128, 128, 255 },   // grey
+   {  64,  64,  64, 255 },   // dark grey
+   {  64,  64, 156, 255 },   // deep blue
+   {   0,   0, 255, 255 },   // blue
+   { 255,   0,   0, 255 },   // red
+   { 255, 255,   0, 255 },   // gold
+   { 180, 150, 110, 255 },   // tan
+   {   0, 150,   0, 255 }    // green
+};
+
+/************************************************************
+ * COLOR RECTANGLE
+ * A structure used to conveniently specify a rectangle 
+ * of a certain color. The parts are all small enough for
+ * their corners to fit in a byte apiece.
+ ************************************************************/
+struct ColorRect
+{
+   int8_t x0;
+   int8_t y0;
+   int8_t x1;
+   int8_t y1;
+   int8_t x2;
+   int8_t y2;
+   int8_t x3;
+   int8_t y3;
+   PaletteColor color;
+};
+
+/************************************************************
+ * TRANSFORM
+ * Where an object is drawn and which way it is turned, ready
+ * to be applied to every vertex of the object
+ ************************************************************/
+struct Transform
+{
+   double x;         // center of rotation, in pixels
+   double y;
+   double offsetX;   // where the part sits on the object, in pixels
+   double offsetY;
+   double cosA;
+   double sinA;
+};
+
+/************************************************************
+ * RUN
+ * Vertices in a row of a mesh that are all one color
+ ************************************************************/
+struct Run
+{
+   uint32_t first;
+   uint32_t count;
+   unsigned char color;   // which of the colors seen so far
+};
+
+// a part's sprites: how many ways it is turned, and how they are laid
+// out in the atlas, each in a square cell just big enough for the part
+const int SPRITE_ROTATIONS = 64;
+const int SPRITE_COLUMNS = 32;
+const int SPRITE_CELL_MOST = 40;
+const int NO_SPRITES = -1;
+const int NO_FIT = -2;
+
+/************************************************************
+ * MESH
+ * The shape of a part, baked once, in pixels relative to the
+ * part's center, along with every place it is drawn this frame
+ ************************************************************/
+struct Mesh
+{
+   std::vector<Vertex> triangles;
+   std::vector<Vertex> lines;
+   std::vector<Transform> instances;
+   bool baked = false;
+
+   // the same part from further away: one box, or one dot, in its
+   // main color
+   std::vector<Vertex> simple;
+   std::vector<Transform> simpleInstances;
+   unsigned char rgba[4] = { 255, 255, 255, 255 };
+
+   // each array split by color, bottom layer first
+   std::vector<Run> triangleRuns;
+   std::vector<Run> lineRuns;
+   std::vector<Run> simpleRuns;
+
+   // the row its sprites start on in the atlas: NO_SPRITES until it
+   // has been tried, and NO_FIT when it is too big to have any
+   int spriteTop = NO_SPRITES;
+   int spriteCell = 0;
+};
+
+/************************************************************
+ * DRAW ITEM
+ * One run of a mesh, to be copied to every place the mesh is
+ * drawn. The key sorts items by primitive, then by how far
+ * down in its part the run is, then by color, so a part's
+ * layers still go on in order.
+ ************************************************************/
+struct DrawItem
+{
+   uint32_t key;
+   const std::vector<Vertex> * pModel;
+   const std::vector<Transform> * pInstances;
+   Run run;
+};
+
+// which array of the frame an item goes to: the top byte of its key
+enum Primitive : unsigned char { PRIMITIVE_TRIANGLES, PRIMITIVE_LINES };
+
+/************************************************************
+ * BATCH
+ * The frame being drawn. The draw* functions only append to
+ * it; drawFlush() hands it to the renderer all at once. The
+ * arrays are cleared, not freed, so after the first few
+ * frames nothing is allocated. Parts are kept as instances of
+ * their mesh until the flush.
+ ************************************************************/
+struct Batch : public Frame
+{
+   std::vector<Mesh *> meshes;      // every part drawn so far
+   unsigned char rgba[4] = { 255, 255, 255, 255 };  // color of the next vertex
+};
+
+static Batch batch;
+
+// where finished frames go; the window unless told otherwise
+static Renderer * pRenderer = NULL;
+
+// this frame's draw calls, and the last frame's once played back
+static CommandList frameCommands;
+static CommandList lastCommands;
+
+// where this thread's draw calls are recorded; NULL draws right away.
+// Only the drawing thread may record into the frame or draw right away
+static thread_local CommandList * pRecording = &frameCommands;
+
+// the thread that draws the frames: whichever draws or flushes first
+static std::atomic<std::thread::id> drawingThread;
+
+// draw a part with no rotation or offset: how its mesh is baked
+const Transform IDENTITY = { 0.0, 0.0, 0.0, 0.0, 1.0, 0.0 };
+
+// how much of the parts drawn next to bother with
+static Detail detail = DETAIL_FULL;
+
+// how often the last frame's parts changed color or primitive
+static StateChanges stateChanges = { 0, 0 };
+
+// what this frame has cost so far, and what the last one did
+static RenderStats frameStats = {};
+static RenderStats lastStats = {};
+
+// the family of draw* calls being timed, FAMILY_COUNT for none, and since when
+static DrawFamily timedFamily = FAMILY_COUNT;
+static std::chrono::steady_clock::time_point familyStart;
+
+// whether parts are drawn as sprites, and the picture they come from
+static bool partSprites = false;
+static Image spriteAtlas = { 0.0f, 0.0f, SPRITE_COLUMNS * SPRITE_CELL_MOST, 0 };
+static unsigned int spriteVersion = 0;
+
+/************************************************************************
+ * ON DRAWING THREAD
+ * Is this the thread that draws the frames? The first to ask claims it.
+ *************************************************************************/
+static bool onDrawingThread()
+{
+   std::thread::id claimed;
+   return drawingThread.compare_exchange_strong(claimed, std::this_thread::get_id()) ||
+          claimed == std::this_thread::get_id();
+}
+
+/************************************************************************
+ * RECORDING
+ * Where this thread's draw calls go. Any other thread must have given
+ * recordInto() a list of its own first, or it would be racing the
+ * drawing thread for the frame.
+ *************************************************************************/
+static inline CommandList * recording()
+{
+   assert((pRecording != &frameCommands && pRecording != NULL) || onDrawingThread());
+   return pRecording;
+}
+
+/************************************************************************
+ * TIME FAMILY
+ * Charge the time since the last switch to the family being timed, then
+ * start timing another. The families come one after another, so the
+ * clock is read a handful of times a frame, not once per call.
+ *************************************************************************/
+static void timeFamily(DrawFamily family)
+{
+   if (!RENDER_STATS || family == timedFamily)
+      return;
+
+   std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+   if (timedFamily != FAMILY_COUNT)
+      frameStats.milliseconds[timedFamily] +=
+         std::chrono::duration<double, std::milli>(now - familyStart).count();
+   timedFamily = family;
+   familyStart = now;
+}
+
+/************************************************************************
+ * COUNT DRAW
+ * One more draw* call has reached the frame
+ *************************************************************************/
+static inline void countDraw(DrawFamily family)
+{
+   if (!RENDER_STATS)
+      return;
+   frameStats.drawCalls++;
+   timeFamily(family);
+}
 
 /************************************************************************
  * ROTATE
- * Rotate a given point (point) around a given origin (center) by a given
- * number of degrees (angle).
+ * Set up the rotation of an object around a given origin (center) by a
+ * given number of radians. This is where the sine and cosine are found,
+ * once for the whole object rather than once per vertex; the parts of a
+ * satellite share one rotation, so they share one pair of calls too.
  *    INPUT  origin   The center point we will rotate around
- *           x,y      Offset from center that we will be rotating, in pixels
- *           rotation Rotation in degrees
- *    OUTPUT point    The new position
+ *           rotation Rotation in radians
+ *           offset   Where the part sits relative to the center
+ *    OUTPUT <return> The transform for the object's vertices
  *************************************************************************/
-Position rotate(const Position& origin, double x, double y, double rotation)
+Transform rotate(const Position& origin, double rotation,
+                 const Position& offset = Position())
 {
-   // because sine and cosine are expensive, we want to call them only once
-   double cosA = cos(rotation);
-   double sinA = sin(rotation);
+   static double lastRotation = 0.0;
+   static double lastCos = 1.0;
+   static double lastSin = 0.0;
+   if (RENDER_STATS)
+      frameStats.rotations++;
+   if (rotation != lastRotation)
+   {
+      lastRotation = rotation;
+      lastCos = cos(rotation);
+      lastSin = sin(rotation);
+   }
 
-   // start with our original point
-   Position ptReturn(origin);
+   Transform transform =
+   {
+      origin.getPixelsX(), origin.getPixelsY(),
+      offset.getPixelsX(), offset.getPixelsY(),
+      lastCos, lastSin
+   };
+   return transform;
+}
 
-   // find the new values
-   ptReturn.addPixelsX(x * cosA + y * sinA);
-   ptReturn.addPixelsY(y * cosA - x * sinA);
+/************************************************************************
+* GL COLOR
+* Set the color of the following vertices
+*   INPUT  color  Which color of the palette
+*************************************************************************/
+inline void glColor(PaletteColor color)
+{
+   memcpy(batch.rgba, PALETTE[color], sizeof(batch.rgba));
+}
 
-   return ptReturn;
+/************************************************************************
+* GL COLOR
+* Set the color of the following vertices
+*   INPUT  red, green, blue  Each 0...255
+*************************************************************************/
+inline void glColor(unsigned char red, unsigned char green, unsigned char blue)
+{
+   batch.rgba[0] = red;
+   batch.rgba[1] = green;
+   batch.rgba[2] = blue;
+   batch.rgba[3] = 255;
 }
 
 /*************************************************************************
- * GL RESET COLOR
- * Just a more convenient way to reset the color
+ * GL VERTEX POINT
+ * Append a vertex in pixels, in the current color, to a batch array
  *************************************************************************/
-inline void glResetColor()
+inline void glVertexPoint(std::vector<Vertex> & vertices, double x, double y)
 {
-   glColor3f((GLfloat)1.0 /* red % */, (GLfloat)1.0 /* green % */, (GLfloat)1.0 /* blue % */);
-}   
+   Vertex vertex;
+   vertex.x = (float)x;
+   vertex.y = (float)y;
+   memcpy(vertex.rgba, batch.rgba, sizeof(vertex.rgba));
+   vertices.push_back(vertex);
+}
 
-/************************************************************
- * COLOR RECTANGLE
- * A structure used to conveniently specify a rectangle 
- * of a certain color
- ************************************************************/
-struct ColorRect
+/*************************************************************************
+ * GL VERTEX POINT
+ * Append a vertex of an object, given in pixels relative to the object
+ *************************************************************************/
+inline void glVertexPoint(std::vector<Vertex> & vertices, const Transform & transform,
+                          double x, double y)
+{
+   x += transform.offsetX;
+   y += transform.offsetY;
+   glVertexPoint(vertices,
+                 transform.x + x * transform.cosA + y * transform.sinA,
+                 transform.y + y * transform.cosA - x * transform.sinA);
+}
+
+/*************************************************************************
+ * GL QUAD
+ * Append a quad as two triangles sharing the 0-2 diagonal, the same
+ * split GL_QUADS makes
+ *************************************************************************/
+inline void glQuad(std::vector<Vertex> & vertices, const Transform & transform,
+                   const PT & p0, const PT & p1, const PT & p2, const PT & p3)
+{
+   glVertexPoint(vertices, transform, p0.x, p0.y);
+   glVertexPoint(vertices, transform, p1.x, p1.y);
+   glVertexPoint(vertices, transform, p2.x, p2.y);
+   glVertexPoint(vertices, transform, p0.x, p0.y);
+   glVertexPoint(vertices, transform, p2.x, p2.y);
+   glVertexPoint(vertices, transform, p3.x, p3.y);
+}
+
+/*************************************************************************
+ * GL LINE
+ * Append one line segment of an object
+ *************************************************************************/
+inline void glLine(std::vector<Vertex> & vertices, const Transform & transform,
+                   double x0, double y0, double x1, double y1)
+{
+   glVertexPoint(vertices, transform, x0, y0);
+   glVertexPoint(vertices, transform, x1, y1);
+}
+
+/*************************************************************************
+ * GL FAN
+ * Append a triangle fan around points[0]
+ *************************************************************************/
+void glFan(std::vector<Vertex> & vertices, const Transform & transform,
+           const PT * points, int num)
+{
+   for (int i = 2; i < num; i++)
+   {
+      glVertexPoint(vertices, transform, points[0].x,     points[0].y);
+      glVertexPoint(vertices, transform, points[i - 1].x, points[i - 1].y);
+      glVertexPoint(vertices, transform, points[i].x,     points[i].y);
+   }
+}
+
+/*************************************************************************
+ * GL DRAW RECT
+ * Draw a colored rectangle
+ *************************************************************************/
+void glDrawRect(std::vector<Vertex> & vertices, const Transform & transform,
+                const ColorRect & rect)
+{
+   glColor(rect.color);
+   glQuad(vertices, transform,
+          { (double)rect.x0, (double)rect.y0 },
+          { (double)rect.x1, (double)rect.y1 },
+          { (double)rect.x2, (double)rect.y2 },
+          { (double)rect.x3, (double)rect.y3 });
+}
+
+/*************************************************************************
+ * GL TRANSFORM
+ * Append a copy of vertices given relative to an object, turned and
+ * moved into place. Colors are copied as they are.
+ *************************************************************************/
+inline void glTransform(std::vector<Vertex> & vertices, const Transform & transform,
+                        const Vertex * model, size_t num)
+{
+   size_t first = vertices.size();
+   vertices.resize(first + num);
+   Vertex * pVertex = &vertices[first];
+   for (size_t i = 0; i < num; i++)
+   {
+      double x = model[i].x + transform.offsetX;
+      double y = model[i].y + transform.offsetY;
+      *pVertex = model[i];
+      pVertex->x = (float)(transform.x + x * transform.cosA + y * transform.sinA);
+      pVertex->y = (float)(transform.y + y * transform.cosA - x * transform.sinA);
+      pVertex++;
+   }
+}
+
+/*************************************************************************
+ * GL DRAW MESH
+ * Draw a mesh right away, in front of everything drawn so far
+ *************************************************************************/
+void glDrawMesh(const Transform & transform, const Mesh & mesh)
+{
+   glTransform(batch.triangles, transform, mesh.triangles.data(), mesh.triangles.size());
+   glTransform(batch.lines,     transform, mesh.lines.data(),     mesh.lines.size());
+}
+
+/*************************************************************************
+ * COLOR ID
+ * A small number for a color: its place in the palette, or, for the few
+ * colors not in it, in the order they were first seen
+ *************************************************************************/
+static unsigned char colorId(const unsigned char * rgba)
+{
+   static std::vector<uint32_t> colors;
+   if (colors.empty())
+      for (const unsigned char * entry : PALETTE)
+      {
+         uint32_t color;
+         memcpy(&color, entry, sizeof(color));
+         colors.push_back(color);
+      }
+
+   uint32_t color;
+   memcpy(&color, rgba, sizeof(color));
+   auto it = std::find(colors.begin(), colors.end(), color);
+   if (it == colors.end())
+   {
+      assert(colors.size() < 256);
+      it = colors.insert(colors.end(), color);
+   }
+   return (unsigned char)(it - colors.begin());
+}
+
+/*************************************************************************
+ * FIND RUNS
+ * Split an array of primitives, each all one color, wherever the
+ * color changes
+ *************************************************************************/
+static void findRuns(const std::vector<Vertex> & vertices, size_t perPrimitive,
+                     std::vector<Run> & runs)
+{
+   runs.clear();
+   for (size_t i = 0; i < vertices.size(); i += perPrimitive)
+   {
+      if (runs.empty() || memcmp(vertices[i].rgba, vertices[i - 1].rgba, 4) != 0)
+         runs.push_back({ (uint32_t)i, 0, colorId(vertices[i].rgba) });
+      runs.back().count += (uint32_t)perPrimitive;
+   }
+}
+
+/*************************************************************************
+ * GL BAKE
+ * A part's mesh is finished: from now on it is drawn at every flush
+ *************************************************************************/
+void glBake(Mesh & mesh)
+{
+   assert(!mesh.baked);
+   mesh.baked = true;
+   batch.meshes.push_back(&mesh);
+
+   if (mesh.triangles.empty())
+   {
+      findRuns(mesh.lines, 2, mesh.lineRuns);
+      return;
+   }
+
+   // the main color is the one covering the most area
+   std::vector<std::pair<uint32_t, double> > areas;
+   double left   = mesh.triangles[0].x, right = left;
+   double bottom = mesh.triangles[0].y, top   = bottom;
+   for (size_t i = 0; i + 2 < mesh.triangles.size(); i += 3)
+   {
+      const Vertex * v = &mesh.triangles[i];
+      double area = fabs((v[1].x - v[0].x) * (v[2].y - v[0].y) -
+                         (v[1].y - v[0].y) * (v[2].x - v[0].x));
+      uint32_t color;
+      memcpy(&color, v[0].rgba, sizeof(color));
+      auto it = std::find_if(areas.begin(), areas.end(),
+                             [color](const std::pair<uint32_t, double> & entry)
+                             { return entry.first == color; });
+      if (it == areas.end())
+         areas.push_back(std::make_pair(color, area));
+      else
+         it->second += area;
+
+      for (int j = 0; j < 3; j++)
+      {
+         left   = min(left,   (double)v[j].x);
+         right  = max(right,  (double)v[j].x);
+         bottom = min(bottom, (double)v[j].y);
+         top    = max(top,    (double)v[j].y);
+      }
+   }
+   auto largest = std::max_element(areas.begin(), areas.end(),
+                                   [](const std::pair<uint32_t, double> & lhs,
+                                      const std::pair<uint32_t, double> & rhs)
+                                   { return lhs.second < rhs.second; });
+   memcpy(mesh.rgba, &largest->first, sizeof(mesh.rgba));
+
+   // the simple mesh is the box around the whole part
+   glColor(mesh.rgba[0], mesh.rgba[1], mesh.rgba[2]);
+   glQuad(mesh.simple, IDENTITY, { left, top }, { right, top },
+          { right, bottom }, { left, bottom });
+
+   findRuns(mesh.triangles, 3, mesh.triangleRuns);
+   findRuns(mesh.lines,     2, mesh.lineRuns);
+   findRuns(mesh.simple,    3, mesh.simpleRuns);
+}
+
+/*************************************************************************
+ * GL DRAW INSTANCE
+ * Draw another copy of a part. Nothing is transformed yet; this only
+ * remembers where the copy goes.
+ *************************************************************************/
+inline void glDrawInstance(Mesh & mesh, const Transform & transform)
+{
+   assert(mesh.baked);
+   countDraw(FAMILY_PARTS);
+   if (detail == DETAIL_FULL)
+      mesh.instances.push_back(transform);
+   else if (detail == DETAIL_SIMPLE)
+      mesh.simpleInstances.push_back(transform);
+   else
+   {
+      // one dot where the part sits
+      double x = transform.offsetX;
+      double y = transform.offsetY;
+      Vertex vertex = { (float)(transform.x + x * transform.cosA + y * transform.sinA),
+                        (float)(transform.y + y * transform.cosA - x * transform.sinA),
+                        { mesh.rgba[0], mesh.rgba[1], mesh.rgba[2], mesh.rgba[3] } };
+      batch.points.push_back(vertex);
+   }
+}
+
+/*************************************************************************
+ * SET RENDERER
+ * Send finished frames somewhere other than the window
+ *************************************************************************/
+void setRenderer(Renderer * pRenderer)
+{
+   ::pRenderer = pRenderer;
+}
+
+/*************************************************************************
+ * RECORD INTO
+ * Send this thread's draw calls to another list, or straight to the frame
+ *************************************************************************/
+CommandList * recordInto(CommandList * pList)
+{
+   CommandList * pSaved = pRecording;
+   pRecording = pList;
+   return pSaved;
+}
+
+/*************************************************************************
+ * DRAW COMMANDS
+ * Queue up a list recorded elsewhere, to be played back with the frame
+ *************************************************************************/
+void drawCommands(const CommandList & list)
+{
+   if (recording())
+      pRecording->append(list);
+   else
+      list.replay();
+}
+
+/*************************************************************************
+ * LAST FRAME COMMANDS
+ *************************************************************************/
+const CommandList & lastFrameCommands()
+{
+   return lastCommands;
+}
+
+/*************************************************************************
+ * DRAW DETAIL
+ * How much of the parts drawn from now on to draw
+ *************************************************************************/
+void drawDetail(Detail detail)
+{
+   if (recording())
+      return pRecording->detail(detail);
+   ::detail = detail;
+}
+
+/*************************************************************************
+ * LAST FRAME STATE CHANGES
+ *************************************************************************/
+StateChanges lastFrameStateChanges()
+{
+   return stateChanges;
+}
+
+/*************************************************************************
+ * LAST FRAME STATS
+ *************************************************************************/
+RenderStats lastFrameStats()
+{
+   return lastStats;
+}
+
+/*************************************************************************
+ * COUNT CULLED
+ *************************************************************************/
+void countCulled(size_t num)
+{
+   if (RENDER_STATS)
+      frameStats.culled += num;
+}
+
+/*************************************************************************
+ * DRAW STATS
+ * One line per count, then one per family that took any time
+ *************************************************************************/
+void drawStats(const Position& topLeft)
+{
+   if (!RENDER_STATS)
+      return;
+
+   static const char * const FAMILY_NAMES[FAMILY_COUNT] =
+   {
+      "stars", "heat map", "earth", "trails", "parts", "text", "render"
+   };
+
+   ogstream gout(topLeft);
+   gout << lastStats.drawCalls    << " draw calls\n"
+        << lastStats.vertices     << " vertices\n"
+        << lastStats.sprites      << " sprites\n"
+        << lastStats.rotations    << " rotations\n"
+        << lastStats.colorChanges << " color changes\n"
+        << lastStats.culled       << " culled\n"
+        << std::fixed << std::setprecision(2);
+   for (int family = 0; family < FAMILY_COUNT; family++)
+      if (lastStats.milliseconds[family] > 0.0)
+         gout << FAMILY_NAMES[family] << " " << lastStats.milliseconds[family] << " ms\n";
+}
+
+/*************************************************************************
+ * GATHER
+ * Add an item for each run of a mesh drawn at least once. Along the way,
+ * count the changes drawing it one copy at a time would have made: the
+ * runs of the first copy, then those of each copy after it.
+ *************************************************************************/
+static void gather(std::vector<DrawItem> & items, Primitive primitive,
+                   const std::vector<Vertex> & model, const std::vector<Run> & runs,
+                   const std::vector<Transform> & instances, uint32_t & last)
+{
+   if (instances.empty() || runs.empty())
+      return;
+
+   size_t within = 0;
+   for (size_t i = 1; i < runs.size(); i++)
+      within += runs[i].color != runs[i - 1].color;
+   uint32_t first = (uint32_t)primitive << 8 | runs.front().color;
+   uint32_t final = (uint32_t)primitive << 8 | runs.back().color;
+   stateChanges.unsorted += (first != last) + within +
+                            (instances.size() - 1) * ((first != final) + within);
+   last = final;
+
+   for (size_t layer = 0; layer < runs.size(); layer++)
+   {
+      uint32_t key = (uint32_t)primitive << 16 |
+                     (uint32_t)min(layer, (size_t)255) << 8 | runs[layer].color;
+      items.push_back({ key, &model, &instances, runs[layer] });
+   }
+}
+
+/*************************************************************************
+ * RADIX SORT
+ * Sort items by their 24 bit keys, a byte at a time from the lowest.
+ * Each pass is stable, so items with the same key keep their order.
+ *************************************************************************/
+static void radixSort(std::vector<DrawItem> & items, std::vector<DrawItem> & scratch)
+{
+   scratch.resize(items.size());
+   for (int shift = 0; shift < 24; shift += 8)
+   {
+      size_t starts[257] = {};
+      for (const DrawItem & item : items)
+         starts[((item.key >> shift) & 0xff) + 1]++;
+      for (int i = 1; i < 257; i++)
+         starts[i] += starts[i - 1];
+      for (const DrawItem & item : items)
+         scratch[starts[(item.key >> shift) & 0xff]++] = item;
+      items.swap(scratch);
+   }
+}
+
+/*************************************************************************
+ * BAKE SPRITES
+ * Paint a part into the atlas turned every way it can be drawn, with the
+ * same renderer that paints offscreen frames. The cell is even, so the
+ * part's center is on a pixel corner, and has a pixel to spare all the
+ * way around. The background is black, which no part is drawn in, so
+ * black is left see-through. A part too big for the largest cell is
+ * left to be drawn as it always was.
+ *************************************************************************/
+static void bakeSprites(Mesh & mesh)
+{
+   double reach = 0.0;
+   for (const Vertex & vertex : mesh.triangles)
+      reach = max(reach, sqrt((double)vertex.x * vertex.x + (double)vertex.y * vertex.y));
+   for (const Vertex & vertex : mesh.lines)
+      reach = max(reach, sqrt((double)vertex.x * vertex.x + (double)vertex.y * vertex.y));
+   int size = 2 * (int)ceil(reach) + 2;
+   if (size > SPRITE_CELL_MOST)
+   {
+      mesh.spriteTop = NO_FIT;
+      return;
+   }
+
+   // the new rows start out see-through
+   mesh.spriteTop = spriteAtlas.height;
+   mesh.spriteCell = size;
+   spriteAtlas.height += SPRITE_ROTATIONS / SPRITE_COLUMNS * size;
+   spriteAtlas.rgba.resize((size_t)spriteAtlas.width * spriteAtlas.height * 4);
+   spriteVersion++;
+
+   SoftwareRenderer painter(size, size);
+   static Frame cell;
+   for (int turn = 0; turn < SPRITE_ROTATIONS; turn++)
+   {
+      double angle = 2.0 * M_PI * turn / SPRITE_ROTATIONS;
+      Transform transform = { 0.0, 0.0, 0.0, 0.0, cos(angle), sin(angle) };
+      cell.clear();
+      glTransform(cell.triangles, transform, mesh.triangles.data(), mesh.triangles.size());
+      glTransform(cell.lines,     transform, mesh.lines.data(),     mesh.lines.size());
+      painter.render(cell);
+
+      int left = (turn % SPRITE_COLUMNS) * size;
+      int top = mesh.spriteTop + (turn / SPRITE_COLUMNS) * size;
+      for (int y = 0; y < size; y++)
+         for (int x = 0; x < size; x++)
+         {
+            const unsigned char * from = painter.getPixels() + ((size_t)y * size + x) * 4;
+            unsigned char * to =
+               &spriteAtlas.rgba[(((size_t)top + y) * spriteAtlas.width + left + x) * 4];
+            if (from[0] | from[1] | from[2])
+            {
+               memcpy(to, from, 3);
+               to[3] = 255;
+            }
+         }
+   }
+}
+
+/*************************************************************************
+ * SET PART SPRITES
+ * Every part is painted into the atlas here rather than in the middle of
+ * the first frame to draw it. A part's mesh is made the first time the
+ * part is drawn, so each is drawn once, right away, and the copies are
+ * taken back before they can reach a frame or its stats.
+ *************************************************************************/
+void setPartSprites(bool sprites)
+{
+   partSprites = sprites;
+   if (!sprites)
+      return;
+
+   CommandList * pSaved = recordInto(NULL);
+   Detail savedDetail = detail;
+   RenderStats savedStats = frameStats;
+   detail = DETAIL_FULL;
+
+   Position center;
+   drawProjectile(center);
+   drawFragment(center, 0.0);
+   drawSputnik(center, 0.0);
+   drawGPS(center, 0.0);
+   drawHubble(center, 0.0);
+   drawCrewDragon(center, 0.0);
+   drawStarlink(center, 0.0);
+   drawShip(center, 0.0, false /*thrust*/);
+
+   for (Mesh * pMesh : batch.meshes)
+   {
+      pMesh->instances.clear();
+      pMesh->simpleInstances.clear();
+      if (pMesh->spriteTop == NO_SPRITES)
+         bakeSprites(*pMesh);
+   }
+
+   frameStats = savedStats;
+   detail = savedDetail;
+   recordInto(pSaved);
+}
+
+/*************************************************************************
+ * ADD SPRITE
+ * One copy of a part as the sprite turned nearest its way, on the
+ * nearest whole pixel. The parts of one satellite share a rotation, so
+ * the turn is worked out again only when it changes.
+ *************************************************************************/
+static inline void addSprite(const Mesh & mesh, const Transform & transform)
 {
-   int x0;
-   int y0;
-   int x1;
-   int y1;
-   int x2;
-   int y2;
-   int x3;
-   int y3;
-   const int* rgb;
-};
+   static double lastCos = 1.0;
+   static double lastSin = 0.0;
+   static int lastTurn = 0;
+   if (transform.cosA != lastCos || transform.sinA != lastSin)
+   {
+      lastCos = transform.cosA;
+      lastSin = transform.sinA;
+      double angle = atan2(transform.sinA, transform.cosA);
+      int turn = (int)floor(angle * SPRITE_ROTATIONS / (2.0 * M_PI) + 0.5);
+      lastTurn = (turn % SPRITE_ROTATIONS + SPRITE_ROTATIONS) % SPRITE_ROTATIONS;
+   }
 
-/************************************************************************
-* GL COLOR
-* Set the color on the board
-*   INPUT  rgb  RGB color in integers (0...255)
-*************************************************************************/
-void glColor(const int* rgb)
-{
-   glColor3f((GLfloat)(rgb[0] / 256.0),
-             (GLfloat)(rgb[1] / 256.0),
-             (GLfloat)(rgb[2] / 256.0));
+   double x = transform.offsetX;
+   double y = transform.offsetY;
+   int size = mesh.spriteCell;
+   Sprite sprite;
+   sprite.x = (float)(floor(transform.x + x * transform.cosA + y * transform.sinA + 0.5)
+                      - size / 2);
+   sprite.y = (float)(floor(transform.y + y * transform.cosA - x * transform.sinA + 0.5)
+                      + size / 2);
+   sprite.u = (unsigned short)(lastTurn % SPRITE_COLUMNS * size);
+   sprite.v = (unsigned short)(mesh.spriteTop + lastTurn / SPRITE_COLUMNS * size);
+   sprite.width = sprite.height = (unsigned short)size;
+   batch.sprites.push_back(sprite);
 }
 
 /*************************************************************************
- * GL VERTEXT POINT
- * Just a more convenient format of glVertext2f
+ * SUBMIT PARTS
+ * Copy every part drawn this frame into place. Rather than one part at
+ * a time, which changes color at nearly every run, the runs are sorted
+ * so every copy of the same layer and color goes out together. When
+ * parts are sprites, each full copy is one sprite instead, and all of
+ * them are one more change.
  *************************************************************************/
-inline void glVertexPoint(const Position & point)
+static void submitParts()
 {
-   glVertex2f((GLfloat)point.getPixelsX(), (GLfloat)point.getPixelsY());
+   // reused from one frame to the next
+   static std::vector<DrawItem> items;
+   static std::vector<DrawItem> scratch;
+
+   items.clear();
+   stateChanges.unsorted = 0;
+   stateChanges.sorted = 0;
+   uint32_t last = UINT32_MAX;
+   for (Mesh * pMesh : batch.meshes)
+   {
+      if (partSprites && pMesh->spriteTop >= 0)
+      {
+         for (const Transform & transform : pMesh->instances)
+            addSprite(*pMesh, transform);
+      }
+      else
+         gather(items, PRIMITIVE_TRIANGLES, pMesh->triangles, pMesh->triangleRuns,
+                pMesh->instances, last);
+      gather(items, PRIMITIVE_TRIANGLES, pMesh->simple, pMesh->simpleRuns,
+             pMesh->simpleInstances, last);
+   }
+   for (Mesh * pMesh : batch.meshes)
+      if (!partSprites || pMesh->spriteTop < 0)
+         gather(items, PRIMITIVE_LINES, pMesh->lines, pMesh->lineRuns,
+                pMesh->instances, last);
+
+   if (!batch.sprites.empty())
+   {
+      batch.pAtlas = &spriteAtlas;
+      batch.atlasVersion = spriteVersion;
+      stateChanges.unsorted++;
+      stateChanges.sorted++;
+   }
+
+   radixSort(items, scratch);
+
+   last = UINT32_MAX;
+   int lastColor = -1;
+   for (const DrawItem & item : items)
+   {
+      uint32_t state = ((item.key >> 8) & 0xff00) | (item.key & 0xff);
+      stateChanges.sorted += state != last;
+      last = state;
+      if (RENDER_STATS)
+      {
+         frameStats.colorChanges += (int)(item.key & 0xff) != lastColor;
+         lastColor = (int)(item.key & 0xff);
+      }
+
+      std::vector<Vertex> & vertices =
+         (item.key >> 16 == PRIMITIVE_LINES) ? batch.lines : batch.triangles;
+      const Vertex * model = item.pModel->data() + item.run.first;
+      for (const Transform & transform : *item.pInstances)
+         glTransform(vertices, transform, model, item.run.count);
+   }
+
+   for (Mesh * pMesh : batch.meshes)
+   {
+      pMesh->instances.clear();
+      pMesh->simpleInstances.clear();
+   }
 }
 
 /*************************************************************************
- * GL DRAW RECT
- * Draw a colored rectangle
+ * DRAW FLUSH
+ * Play back the frame's commands, then hand it to the renderer. Parts
+ * come after the shapes drawn directly (the earth), sorted by layer and
+ * color. The frame's stats are done once it is rendered.
  *************************************************************************/
-void glDrawRect(const Position & center, const Position & offset,
-                const ColorRect & rect, double rotation)
-{
-   glBegin(GL_QUADS);
-   glColor(rect.rgb);
-   glVertexPoint(rotate(center,
-                        rect.x0 + offset.getPixelsX(),
-                        rect.y0 + offset.getPixelsY(),
-                        rotation));
-   glVertexPoint(rotate(center,
-                        rect.x1 + offset.getPixelsX(),
-                        rect.y1 + offset.getPixelsY(),
-                        rotation));
-   glVertexPoint(rotate(center,
-                        rect.x2 + offset.getPixelsX(),
-                        rect.y2 + offset.getPixelsY(),
-                        rotation));
-   glVertexPoint(rotate(center,
-                        rect.x3 + offset.getPixelsX(),
-                        rect.y3 + offset.getPixelsY(),
-                        rotation));
-   glEnd();
+void drawFlush()
+{
+   assert(onDrawingThread());
+   frameCommands.replay();
+   std::swap(frameCommands, lastCommands);
+   frameCommands.clear();
+
+   timeFamily(FAMILY_PARTS);
+   submitParts();
+   detail = DETAIL_FULL;
+
+   timeFamily(FAMILY_RENDER);
+   if (pRenderer)
+      pRenderer->render(batch);
+   else
+   {
+      static GLRenderer glRenderer;
+      glRenderer.render(batch);
+   }
+   timeFamily(FAMILY_COUNT);
+
+   if (RENDER_STATS)
+   {
+      frameStats.vertices = batch.points.size() + batch.trails.size() +
+                            batch.triangles.size() + batch.lines.size();
+      frameStats.sprites = batch.sprites.size();
+      lastStats = frameStats;
+      frameStats = RenderStats();
+   }
+   batch.clear();
 }
 
 /*************************************************************************
@@ -161,15 +986,26 @@ void glDrawRect(const Position & center, const Position & offset,
  ************************************************************************/
 void drawText(const Position& topLeft, const char* text)
 {
-   void* pFont = GLUT_BITMAP_HELVETICA_12;  // also try _18
-
-   // prepare to draw the text from the top-left corner
-   glRasterPos2f((GLfloat)topLeft.getPixelsX(),
-                 (GLfloat)topLeft.getPixelsY());
+   drawText(topLeft, text, strlen(text));
+}
 
-   // loop through the text
-   for (const char* p = text; *p; p++)
-      glutBitmapCharacter(pFont, *p);
+/*************************************************************************
+ * DRAW TEXT
+ * Draw the first few characters of a string
+ *   INPUT  topLeft   The top left corner of the text
+ *          text      The text to be displayed
+ *          length    How many characters of it
+ ************************************************************************/
+void drawText(const Position& topLeft, const char* text, size_t length)
+{
+   if (recording())
+      return pRecording->text(topLeft, text, length);
+   countDraw(FAMILY_TEXT);
+
+   Text line = { (float)topLeft.getPixelsX(), (float)topLeft.getPixelsY(),
+                 batch.characters.size(), length };
+   batch.characters.append(text, length);
+   batch.texts.push_back(line);
 }
 
 /*************************************************************************
@@ -177,26 +1013,22 @@ void drawText(const Position& topLeft, const char* text)
  *************************************************************************/
 void ogstream :: flush()
 {
-   string sOut;
    string sIn = str();
 
-   // copy everything but the newlines
-   for (string::iterator it = sIn.begin(); it != sIn.end(); ++it)
-      // newline triggers an buffer flush and a move down
-      if (*it == '\n')
-      {
-         drawText(pt, sOut.c_str());
-         sOut.clear();
-         pt.addPixelsY(-18);
-      }
-      // othewise append
-      else
-         sOut += *it;
+   // each line is drawn straight out of the buffer; a newline moves down
+   size_t begin = 0;
+   size_t end;
+   while ((end = sIn.find('\n', begin)) != string::npos)
+   {
+      drawText(pt, sIn.data() + begin, end - begin);
+      pt.addPixelsY(-18);
+      begin = end + 1;
+   }
 
-   // put the text on the screen
-   if (!sOut.empty())
+   // put the rest on the screen
+   if (begin < sIn.size())
    {
-      drawText(pt, sOut.c_str());
+      drawText(pt, sIn.data() + begin, sIn.size() - begin);
       pt.addPixelsY(-18);
    }
    
@@ -211,13 +1043,23 @@ void ogstream :: flush()
  *************************************************************************/
 void drawProjectile(const Position& pt)
 {
-   ColorRect rects[] =
+   if (recording())
+      return pRecording->projectile(pt);
+
+   static Mesh mesh;
+   if (!mesh.baked)
    {
-      {1,1, -1,1, -1,-1, 1,-1, RGB_WHITE },
-   };
+      ColorRect rects[] =
+      {
+         {1,1, -1,1, -1,-1, 1,-1, RGB_WHITE },
+      };
+
+      for (int i = 0; i < sizeof(rects) / sizeof(ColorRect); i++)
+         glDrawRect(mesh.triangles, IDENTITY, rects[i]);
 
-   for (int i = 0; i < sizeof(rects) / sizeof(ColorRect); i++)
-      glDrawRect(pt, Position(), rects[i], 0.0);
+      glBake(mesh);
+   }
+   glDrawInstance(mesh, rotate(pt, 0.0));
 }
 
 /************************************************************************
@@ -228,13 +1070,23 @@ void drawProjectile(const Position& pt)
  *************************************************************************/
 void drawFragment(const Position& center, double rotation)
 {
-   ColorRect rects[] =
+   if (recording())
+      return pRecording->part(OP_FRAGMENT, center, rotation);
+
+   static Mesh mesh;
+   if (!mesh.baked)
    {
-      {-4,1, -4,-1, 4,-1, 4,1, RGB_LIGHT_GREY },
-   };
+      ColorRect rects[] =
+      {
+         {-4,1, -4,-1, 4,-1, 4,1, RGB_LIGHT_GREY },
+      };
 
-   for (int i = 0; i < sizeof(rects) / sizeof(ColorRect); i++)
-      glDrawRect(center, Position(), rects[i], rotation);
+      for (int i = 0; i < sizeof(rects) / sizeof(ColorRect); i++)
+         glDrawRect(mesh.triangles, IDENTITY, rects[i]);
+
+      glBake(mesh);
+   }
+   glDrawInstance(mesh, rotate(center, rotation));
 }
 
 /************************************************************************
@@ -245,16 +1097,26 @@ void drawFragment(const Position& center, double rotation)
  *************************************************************************/
 void drawCrewDragonCenter(const Position& center, double rotation)
 {
-   ColorRect rects[] = 
+   if (recording())
+      return pRecording->part(OP_CREW_DRAGON_CENTER, center, rotation);
+
+   static Mesh mesh;
+   if (!mesh.baked)
    {
-      {-5,5,   3,5,   3,-5,  -5,-5,  RGB_LIGHT_GREY },
-      { 3,5,   3,-5, 11,-3,  11,3,   RGB_GREY },
-      {12,-3, 12,3,  11,-3,  11,3,   RGB_DARK_GREY },
-      { 4,3,   7,2,   7,-2,   4,-3,  RGB_DARK_GREY}
-   };
+      ColorRect rects[] = 
+      {
+         {-5,5,   3,5,   3,-5,  -5,-5,  RGB_LIGHT_GREY },
+         { 3,5,   3,-5, 11,-3,  11,3,   RGB_GREY },
+         {12,-3, 12,3,  11,-3,  11,3,   RGB_DARK_GREY },
+         { 4,3,   7,2,   7,-2,   4,-3,  RGB_DARK_GREY}
+      };
+
+      for (int i = 0; i < sizeof(rects)/sizeof(ColorRect); i++)
+         glDrawRect(mesh.triangles, IDENTITY, rects[i]);
 
-   for (int i = 0; i < sizeof(rects)/sizeof(ColorRect); i++)
-      glDrawRect(center, Position(), rects[i], rotation);
+      glBake(mesh);
+   }
+   glDrawInstance(mesh, rotate(center, rotation));
 }
 
 /************************************************************************
@@ -267,15 +1129,25 @@ void drawCrewDragonCenter(const Position& center, double rotation)
  *************************************************************************/
 void drawCrewDragonRight(const Position& center, double rotation, const Position& offset)
 {
-   ColorRect rects[] =
+   if (recording())
+      return pRecording->part(OP_CREW_DRAGON_RIGHT, center, rotation, offset);
+
+   static Mesh mesh;
+   if (!mesh.baked)
    {
-      {-4,5,  4,5,  4,1,  -4,1,  RGB_DEEP_BLUE },
-      {-4,-1, 4,1,  4,-5, -4,-5, RGB_DEEP_BLUE },
-      {0,2,   0,-6, 1,-6,  1,2,  RGB_GREY },
-   };
+      ColorRect rects[] =
+      {
+         {-4,5,  4,5,  4,1,  -4,1,  RGB_DEEP_BLUE },
+         {-4,-1, 4,1,  4,-5, -4,-5, RGB_DEEP_BLUE },
+         {0,2,   0,-6, 1,-6,  1,2,  RGB_GREY },
+      };
 
-   for (int i = 0; i < sizeof(rects) / sizeof(ColorRect); i++)
-      glDrawRect(center, offset, rects[i], rotation);
+      for (int i = 0; i < sizeof(rects) / sizeof(ColorRect); i++)
+         glDrawRect(mesh.triangles, IDENTITY, rects[i]);
+
+      glBake(mesh);
+   }
+   glDrawInstance(mesh, rotate(center, rotation, offset));
 }
 
 /************************************************************************
@@ -288,15 +1160,25 @@ void drawCrewDragonRight(const Position& center, double rotation, const Position
  *************************************************************************/
 void drawCrewDragonLeft(const Position& center, double rotation, const Position& offset)
 {
-   ColorRect rects[] =
+   if (recording())
+      return pRecording->part(OP_CREW_DRAGON_LEFT, center, rotation, offset);
+
+   static Mesh mesh;
+   if (!mesh.baked)
    {
-      {-4,5,  4,5,  4,1,  -4,1,  RGB_DEEP_BLUE },
-      {-4,-1, 4,1,  4,-5, -4,-5, RGB_DEEP_BLUE },
-      {0,2,   0,-6, 1,-6,  1,2,  RGB_GREY }
-   };
+      ColorRect rects[] =
+      {
+         {-4,5,  4,5,  4,1,  -4,1,  RGB_DEEP_BLUE },
+         {-4,-1, 4,1,  4,-5, -4,-5, RGB_DEEP_BLUE },
+         {0,2,   0,-6, 1,-6,  1,2,  RGB_GREY }
+      };
+
+      for (int i = 0; i < sizeof(rects) / sizeof(ColorRect); i++)
+         glDrawRect(mesh.triangles, IDENTITY, rects[i]);
 
-   for (int i = 0; i < sizeof(rects) / sizeof(ColorRect); i++)
-      glDrawRect(center, offset, rects[i], rotation);
+      glBake(mesh);
+   }
+   glDrawInstance(mesh, rotate(center, rotation, offset));
 }
 
 
@@ -329,33 +1211,31 @@ void drawCrewDragon(const Position& center, double rotation)
  *************************************************************************/
 void drawSputnik(const Position& center, double rotation)
 {
-   // draw the sphere                                               
-   const PT pointsSphere[] =
-   {
-      {0,0},
-      {2,6}, {6,2}, {6,-2}, {2,-6}, {-2,-6}, {-2,-6}, {-6,-2}, {-6,2}, {-2,6}, {2,6}
-   };
-   glBegin(GL_TRIANGLE_FAN);
-   glColor(RGB_GREY);
-   for (int i = 0; i < sizeof(pointsSphere) / sizeof(PT); i++)
-      glVertexPoint(rotate(center, pointsSphere[i].x, pointsSphere[i].y, rotation));
-   glEnd();
-
-   // draw the antenna
-   glBegin(GL_LINES);
-   glColor(RGB_WHITE);
-   glVertexPoint(rotate(center,  -6.0,   2.0, rotation));
-   glVertexPoint(rotate(center, -10.0, -15.0, rotation));
+   if (recording())
+      return pRecording->part(OP_SPUTNIK, center, rotation);
 
-   glVertexPoint(rotate(center,  0.0,   1.0, rotation));
-   glVertexPoint(rotate(center, -2.5, -15.0, rotation));
-
-   glVertexPoint(rotate(center,  2.0, -6.0, rotation));
-   glVertexPoint(rotate(center,  2.5, -15.0, rotation));
-
-   glVertexPoint(rotate(center,  6.0,  2.0, rotation));
-   glVertexPoint(rotate(center, 10.0, -15.0, rotation));
-   glEnd();
+   static Mesh mesh;
+   if (!mesh.baked)
+   {
+      // draw the sphere                                               
+      const PT pointsSphere[] =
+      {
+         {0,0},
+         {2,6}, {6,2}, {6,-2}, {2,-6}, {-2,-6}, {-2,-6}, {-6,-2}, {-6,2}, {-2,6}, {2,6}
+      };
+      glColor(RGB_GREY);
+      glFan(mesh.triangles, IDENTITY, pointsSphere, sizeof(pointsSphere) / sizeof(PT));
+
+      // draw the antenna
+      glColor(RGB_WHITE);
+      glLine(mesh.lines, IDENTITY, -6.0,  2.0, -10.0, -15.0);
+      glLine(mesh.lines, IDENTITY,  0.0,  1.0,  -2.5, -15.0);
+      glLine(mesh.lines, IDENTITY,  2.0, -6.0,   2.5, -15.0);
+      glLine(mesh.lines, IDENTITY,  6.0,  2.0,  10.0, -15.0);
+
+      glBake(mesh);
+   }
+   glDrawInstance(mesh, rotate(center, rotation));
 }
 
 /************************************************************************
@@ -368,33 +1248,31 @@ void drawSputnik(const Position& center, double rotation)
  *************************************************************************/
 void drawGPSLeft(const Position& center, double rotation, const Position& offset)
 {
-   ColorRect rects[] =
+   if (recording())
+      return pRecording->part(OP_GPS_LEFT, center, rotation, offset);
+
+   static Mesh mesh;
+   if (!mesh.baked)
    {
-      {-6,5,  6,5,  6,1,  -6,1,  RGB_WHITE},
-      {-6,0,  6,0,  6,-4, -6,-4, RGB_WHITE},
-      {-5,4,  5,4,  5,2,  -5,2,  RGB_DEEP_BLUE },
-      {-5,-1, 5,-1, 5,-3, -5,-3, RGB_DEEP_BLUE }
-   };
+      ColorRect rects[] =
+      {
+         {-6,5,  6,5,  6,1,  -6,1,  RGB_WHITE},
+         {-6,0,  6,0,  6,-4, -6,-4, RGB_WHITE},
+         {-5,4,  5,4,  5,2,  -5,2,  RGB_DEEP_BLUE },
+         {-5,-1, 5,-1, 5,-3, -5,-3, RGB_DEEP_BLUE }
+      };
 
-   for (int i = 0; i < sizeof(rects) / sizeof(ColorRect); i++)
-      glDrawRect(center, offset, rects[i], rotation);
+      for (int i = 0; i < sizeof(rects) / sizeof(ColorRect); i++)
+         glDrawRect(mesh.triangles, IDENTITY, rects[i]);
 
-   // draw the line connecting the solar array to the rest of the ship
-   glBegin(GL_LINE_STRIP);
-   glColor(RGB_WHITE);
-   glVertexPoint(rotate(center,
-                        3.0 + offset.getPixelsX(),
-                        4.0 + offset.getPixelsY(),
-                        rotation));
-   glVertexPoint(rotate(center,
-                        0.0 + offset.getPixelsX(),
-                        8.0 + offset.getPixelsY(),
-                        rotation));
-   glVertexPoint(rotate(center,
-                        -3.0 + offset.getPixelsX(),
-                        4.0 + offset.getPixelsY(),
-                        rotation));
-   glEnd();
+      // draw the line connecting the solar array to the rest of the ship
+      glColor(RGB_WHITE);
+      glLine(mesh.lines, IDENTITY, 3.0, 4.0, 0.0, 8.0);
+      glLine(mesh.lines, IDENTITY, 0.0, 8.0, -3.0, 4.0);
+
+      glBake(mesh);
+   }
+   glDrawInstance(mesh, rotate(center, rotation, offset));
 }
 
 /************************************************************************
@@ -405,36 +1283,33 @@ void drawGPSLeft(const Position& center, double rotation, const Position& offset
  *        offset    For pieces of the satellite, this is the relative position of the center
  *                  of rotation when it is connected to the main satellite
  *************************************************************************/
-void drawGPSRight(const Position& center, const Position& offset, double rotation)
+void drawGPSRight(const Position& center, double rotation, const Position& offset)
 {
-   ColorRect rects[] =
+   if (recording())
+      return pRecording->part(OP_GPS_RIGHT, center, rotation, offset);
+
+   static Mesh mesh;
+   if (!mesh.baked)
    {
-      {-6,-5, 6,-5, 6,-1, -6,-1,  RGB_WHITE},
-      {-6,0,  6,0,  6,4,  -6,4,   RGB_WHITE},
-      {-5,-4, 5,-4, 5,-2, -5,-2,  RGB_DEEP_BLUE },
-      {-5,1,  5,1,  5,3,  -5,3,   RGB_DEEP_BLUE }
-   };
+      ColorRect rects[] =
+      {
+         {-6,-5, 6,-5, 6,-1, -6,-1,  RGB_WHITE},
+         {-6,0,  6,0,  6,4,  -6,4,   RGB_WHITE},
+         {-5,-4, 5,-4, 5,-2, -5,-2,  RGB_DEEP_BLUE },
+         {-5,1,  5,1,  5,3,  -5,3,   RGB_DEEP_BLUE }
+      };
 
-   for (int i = 0; i < sizeof(rects) / sizeof(ColorRect); i++)
-      glDrawRect(center, offset, rects[i], rotation);
+      for (int i = 0; i < sizeof(rects) / sizeof(ColorRect); i++)
+         glDrawRect(mesh.triangles, IDENTITY, rects[i]);
 
-   // draw the line connecting the solar array to the rest of the ship
-   glBegin(GL_LINE_STRIP);
-   glColor(RGB_WHITE);
-   glVertexPoint(rotate(center,
-                        3.0 + offset.getPixelsX(),
-                        -4.0 + offset.getPixelsY(),
-                        rotation));
-   glVertexPoint(rotate(center,
-                        0.0 + offset.getPixelsX(),
-                        -8.0 + offset.getPixelsY(),
-                        rotation));
-   glVertexPoint(rotate(center,
-                        -3.0 + offset.getPixelsX(),
-                        -4.0 + offset.getPixelsY(),
-                        rotation));
-   glEnd();
+      // draw the line connecting the solar array to the rest of the ship
+      glColor(RGB_WHITE);
+      glLine(mesh.lines, IDENTITY, 3.0, -4.0, 0.0, -8.0);
+      glLine(mesh.lines, IDENTITY, 0.0, -8.0, -3.0, -4.0);
 
+      glBake(mesh);
+   }
+   glDrawInstance(mesh, rotate(center, rotation, offset));
 }
 
 /************************************************************************
@@ -445,16 +1320,26 @@ void drawGPSRight(const Position& center, const Position& offset, double rotatio
  *************************************************************************/
 void drawGPSCenter(const Position& center, double rotation)
 {
-   ColorRect rects[4] =
+   if (recording())
+      return pRecording->part(OP_GPS_CENTER, center, rotation);
+
+   static Mesh mesh;
+   if (!mesh.baked)
    {
-      {-3,4,  4,4,  4,-4, -3,-4, RGB_GOLD  },
-      {4,4,  -3,4, -3,-4, -4,-4, RGB_WHITE },
-      {4,3,   7,3,   7,1,   4,1, RGB_GREY  },
-      {4,-3, 7,-3,  7,-1,  4,-1, RGB_GREY  }
-   };
+      ColorRect rects[4] =
+      {
+         {-3,4,  4,4,  4,-4, -3,-4, RGB_GOLD  },
+         {4,4,  -3,4, -3,-4, -4,-4, RGB_WHITE },
+         {4,3,   7,3,   7,1,   4,1, RGB_GREY  },
+         {4,-3, 7,-3,  7,-1,  4,-1, RGB_GREY  }
+      };
+
+      for (int i = 0; i < sizeof(rects) / sizeof(ColorRect); i++)
+         glDrawRect(mesh.triangles, IDENTITY, rects[i]);
 
-   for (int i = 0; i < sizeof(rects) / sizeof(ColorRect); i++)
-      glDrawRect(center, Position(), rects[i], rotation);
+      glBake(mesh);
+   }
+   glDrawInstance(mesh, rotate(center, rotation));
 }
 
 /************************************************************************
@@ -488,15 +1373,25 @@ void drawGPS(const Position& center, double rotation)
  *************************************************************************/
 void drawHubbleTelescope(const Position& center, double rotation, const Position& offset)
 {
-   ColorRect rects[] =
+   if (recording())
+      return pRecording->part(OP_HUBBLE_TELESCOPE, center, rotation, offset);
+
+   static Mesh mesh;
+   if (!mesh.baked)
    {
-      {-9,3,  11,3,  11,-3, -9,-3,  RGB_LIGHT_GREY},
-      {11,3,  15,6,  16,5,  12,2,   RGB_GREY},
-      {-9,-2, 11,-2, 11,-3, -9,-3,  RGB_GREY}
-   };
+      ColorRect rects[] =
+      {
+         {-9,3,  11,3,  11,-3, -9,-3,  RGB_LIGHT_GREY},
+         {11,3,  15,6,  16,5,  12,2,   RGB_GREY},
+         {-9,-2, 11,-2, 11,-3, -9,-3,  RGB_GREY}
+      };
 
-   for (int i = 0; i < sizeof(rects) / sizeof(ColorRect); i++)
-      glDrawRect(center, offset, rects[i], rotation);
+      for (int i = 0; i < sizeof(rects) / sizeof(ColorRect); i++)
+         glDrawRect(mesh.triangles, IDENTITY, rects[i]);
+
+      glBake(mesh);
+   }
+   glDrawInstance(mesh, rotate(center, rotation, offset));
 }
 
 /************************************************************************
@@ -509,16 +1404,26 @@ void drawHubbleTelescope(const Position& center, double rotation, const Position
  *************************************************************************/
 void drawHubbleComputer(const Position& center, double rotation, const Position& offset)
 {
-   ColorRect rects[] =
+   if (recording())
+      return pRecording->part(OP_HUBBLE_COMPUTER, center, rotation, offset);
+
+   static Mesh mesh;
+   if (!mesh.baked)
    {
-      {-5,5,   0,5,  0,-3, -5,-3,  RGB_GREY},
-      {-5,-5,  0,-5, 0,-3, -5,-3,  RGB_DARK_GREY},
-      { 0,4,   3,4,  3,-2,  0,-2,  RGB_GREY},
-      { 0,-4,  3,-4, 3,-2,  0,-2,  RGB_DARK_GREY},
-   };
+      ColorRect rects[] =
+      {
+         {-5,5,   0,5,  0,-3, -5,-3,  RGB_GREY},
+         {-5,-5,  0,-5, 0,-3, -5,-3,  RGB_DARK_GREY},
+         { 0,4,   3,4,  3,-2,  0,-2,  RGB_GREY},
+         { 0,-4,  3,-4, 3,-2,  0,-2,  RGB_DARK_GREY},
+      };
+
+      for (int i = 0; i < sizeof(rects) / sizeof(ColorRect); i++)
+         glDrawRect(mesh.triangles, IDENTITY, rects[i]);
 
-   for (int i = 0; i < sizeof(rects) / sizeof(ColorRect); i++)
-      glDrawRect(center, offset, rects[i], rotation);
+      glBake(mesh);
+   }
+   glDrawInstance(mesh, rotate(center, rotation, offset));
 }
 
 /************************************************************************
@@ -531,28 +1436,29 @@ void drawHubbleComputer(const Position& center, double rotation, const Position&
  *************************************************************************/
 void drawHubbleLeft(const Position& center, double rotation, const Position& offset)
 {
-   ColorRect rects[] =
+   if (recording())
+      return pRecording->part(OP_HUBBLE_LEFT, center, rotation, offset);
+
+   static Mesh mesh;
+   if (!mesh.baked)
    {
-      {-8,3, -1,3, -1,-1, -8,-1,  RGB_LIGHT_GREY},
-      { 8,3,  1,3,  1,-1,  8,-1,  RGB_LIGHT_GREY},
-      {-7,2, -1,2, -2,0,  -7,0,   RGB_DARK_GREY},
-      { 7,2,  1,2,  2,0,   7,0,   RGB_DARK_GREY}
-   };
+      ColorRect rects[] =
+      {
+         {-8,3, -1,3, -1,-1, -8,-1,  RGB_LIGHT_GREY},
+         { 8,3,  1,3,  1,-1,  8,-1,  RGB_LIGHT_GREY},
+         {-7,2, -1,2, -2,0,  -7,0,   RGB_DARK_GREY},
+         { 7,2,  1,2,  2,0,   7,0,   RGB_DARK_GREY}
+      };
 
-   for (int i = 0; i < sizeof(rects) / sizeof(ColorRect); i++)
-      glDrawRect(center, offset, rects[i], rotation);
+      for (int i = 0; i < sizeof(rects) / sizeof(ColorRect); i++)
+         glDrawRect(mesh.triangles, IDENTITY, rects[i]);
 
-   glBegin(GL_LINE_STRIP);
-   glColor(RGB_WHITE);
-   glVertexPoint(rotate(center,
-                        0.0 + offset.getPixelsX(),
-                        3.0 + offset.getPixelsY(),
-                        rotation));
-   glVertexPoint(rotate(center,
-                        0.0 + offset.getPixelsX(),
-                        -5.0 + offset.getPixelsY(),
-                        rotation));
-   glEnd();
+      glColor(RGB_WHITE);
+      glLine(mesh.lines, IDENTITY, 0.0, 3.0, 0.0, -5.0);
+
+      glBake(mesh);
+   }
+   glDrawInstance(mesh, rotate(center, rotation, offset));
 }
 
 
@@ -566,28 +1472,29 @@ void drawHubbleLeft(const Position& center, double rotation, const Position& off
  *************************************************************************/
 void drawHubbleRight(const Position& center, double rotation, const Position& offset)
 {
-   ColorRect rects[] =
+   if (recording())
+      return pRecording->part(OP_HUBBLE_RIGHT, center, rotation, offset);
+
+   static Mesh mesh;
+   if (!mesh.baked)
    {
-      {-8,-3, -1,-3, -1,1,  -8,1,  RGB_LIGHT_GREY},
-      { 8,-3,  1,-3,  1,1,   8,1,  RGB_LIGHT_GREY},
-      {-7,-2, -1,-2, -2,0,  -7,0,  RGB_DARK_GREY},
-      { 7,-2,  1,-2,  2,0,   7,0,  RGB_DARK_GREY}
-   };
+      ColorRect rects[] =
+      {
+         {-8,-3, -1,-3, -1,1,  -8,1,  RGB_LIGHT_GREY},
+         { 8,-3,  1,-3,  1,1,   8,1,  RGB_LIGHT_GREY},
+         {-7,-2, -1,-2, -2,0,  -7,0,  RGB_DARK_GREY},
+         { 7,-2,  1,-2,  2,0,   7,0,  RGB_DARK_GREY}
+      };
+
+      for (int i = 0; i < sizeof(rects) / sizeof(ColorRect); i++)
+         glDrawRect(mesh.triangles, IDENTITY, rects[i]);
 
-   for (int i = 0; i < sizeof(rects) / sizeof(ColorRect); i++)
-      glDrawRect(center, offset, rects[i], rotation);
+      glColor(RGB_WHITE);
+      glLine(mesh.lines, IDENTITY, 0.0, -3.0, 0.0, 5.0);
 
-   glBegin(GL_LINE_STRIP);
-   glColor(RGB_WHITE);
-   glVertexPoint(rotate(center,
-                        0.0 + offset.getPixelsX(),
-                        -3.0 + offset.getPixelsY(),
-                        rotation));
-   glVertexPoint(rotate(center,
-                        0.0 + offset.getPixelsX(),
-                        5.0 + offset.getPixelsY(),
-                        rotation));
-   glEnd();
+      glBake(mesh);
+   }
+   glDrawInstance(mesh, rotate(center, rotation, offset));
 }
 
 /************************************************************************
@@ -629,15 +1536,25 @@ void drawHubble(const Position& center, double rotation)
  *************************************************************************/
 void drawStarlinkBody(const Position& center, double rotation, const Position& offset)
 {
-   ColorRect rects[] =
+   if (recording())
+      return pRecording->part(OP_STARLINK_BODY, center, rotation, offset);
+
+   static Mesh mesh;
+   if (!mesh.baked)
    {
-      {1,5,    1,-3, -1,-5, -1,3,  RGB_LIGHT_GREY},
-      {-4,-5, -1,-5, -1,3,  -4,3,  RGB_GREY},
-      {-4,3,  -2,3,   1,5,  -1,3,  RGB_WHITE}
-   };
+      ColorRect rects[] =
+      {
+         {1,5,    1,-3, -1,-5, -1,3,  RGB_LIGHT_GREY},
+         {-4,-5, -1,-5, -1,3,  -4,3,  RGB_GREY},
+         {-4,3,  -2,3,   1,5,  -1,3,  RGB_WHITE}
+      };
 
-   for (int i = 0; i < sizeof(rects) / sizeof(ColorRect); i++)
-      glDrawRect(center, offset, rects[i], rotation);
+      for (int i = 0; i < sizeof(rects) / sizeof(ColorRect); i++)
+         glDrawRect(mesh.triangles, IDENTITY, rects[i]);
+
+      glBake(mesh);
+   }
+   glDrawInstance(mesh, rotate(center, rotation, offset));
 }
 
 /************************************************************************
@@ -650,14 +1567,24 @@ void drawStarlinkBody(const Position& center, double rotation, const Position& o
  *************************************************************************/
 void drawStarlinkArray(const Position& center, double rotation, const Position& offset)
 {
-   ColorRect rects[] =
+   if (recording())
+      return pRecording->part(OP_STARLINK_ARRAY, center, rotation, offset);
+
+   static Mesh mesh;
+   if (!mesh.baked)
    {
-      {-7,7, 8,2, 8,-6, -7,-1,  RGB_GREY},
-      {-6,6, 7,1, 7,-5, -6,0,   RGB_DEEP_BLUE}
-   };
+      ColorRect rects[] =
+      {
+         {-7,7, 8,2, 8,-6, -7,-1,  RGB_GREY},
+         {-6,6, 7,1, 7,-5, -6,0,   RGB_DEEP_BLUE}
+      };
+
+      for (int i = 0; i < sizeof(rects) / sizeof(ColorRect); i++)
+         glDrawRect(mesh.triangles, IDENTITY, rects[i]);
 
-   for (int i = 0; i < sizeof(rects) / sizeof(ColorRect); i++)
-      glDrawRect(center, offset, rects[i], rotation);
+      glBake(mesh);
+   }
+   glDrawInstance(mesh, rotate(center, rotation, offset));
 }
 
 /************************************************************************
@@ -690,72 +1617,84 @@ void drawStarlink(const Position& center, double rotation)
  *************************************************************************/
 void drawShip(const Position& center, double rotation, bool thrust)
 {
-   // draw the white part of the ship                                               
-   const PT pointsShipWhite[] =
-   { 
-      {0,0},
-      {-3,-9}, {-12,-12}, {-14,-12}, {-13,-7}, {-8,-2}, {-6,3}, {-4,11}, {-4,14}, {-3,16}, {-1,18},
-      {1,18}, {3,16}, {4,14}, {4,11}, {6,3}, {8,-2}, {13,-7}, {14,-12}, {12,-12}, {3,-9}, {-3,-9}
-   };
-
-   glBegin(GL_TRIANGLE_FAN);
-   glColor(RGB_LIGHT_GREY);
-   for (int i = 0; i < sizeof(pointsShipWhite) / sizeof(PT); i++)
-      glVertexPoint(rotate(center, pointsShipWhite[i].x, pointsShipWhite[i].y, rotation));
-   glEnd();
-
-   // draw the flame if necessary
+   // the flame flickers: pick where its two tips go this frame
+   double flame[4];
    if (thrust)
-   {
-      glBegin(GL_TRIANGLES);
-      glColor(RGB_RED);
-      glVertexPoint(rotate(center, -3.0, -9.0, rotation));
-      glVertexPoint(rotate(center, random(-5.0, 5.0), random(-25.0, -13.0), rotation));
-      glVertexPoint(rotate(center, 3.0, -9.0, rotation));
-      glVertexPoint(rotate(center, -3.0, -9.0, rotation));
-      glVertexPoint(rotate(center, random(-5.0, 5.0), random(-25.0, -13.0), rotation));
-      glVertexPoint(rotate(center, 3.0, -9.0, rotation));
-      glResetColor();
-      glEnd();
-   }
-
-   // draw the dark part of the ship                                               
-   const PT pointsShipBlack[][4] =
-   {
-      {{-5,-8},  {-12,-11},{-11,-7},{-5,-2}}, // left wing
-      {{ 5,-8},  { 12,-11},{ 11,-7},{ 5,-2}}, // right wing
-      {{ 0,-13}, {-3,11},  {-1,15}, {1,15}},  // left canopy
-      {{ 0,-13}, { 3,11},  { 1,15}, {-1,15}}  // right canopy
-   };
-   glBegin(GL_QUADS);
-   glColor(RGB_DEEP_BLUE);
-   for (int iRectangle = 0; iRectangle < 4; iRectangle++)
-      for (int iVertex = 0; iVertex < 4; iVertex++)
-      glVertexPoint(rotate(center, pointsShipBlack[iRectangle][iVertex].x, 
-                                   pointsShipBlack[iRectangle][iVertex].y, rotation));
-   glResetColor();
-   glEnd();
+      for (int i = 0; i < 2; i++)
+      {
+         flame[i * 2 + 0] = random(-5.0, 5.0);
+         flame[i * 2 + 1] = random(-25.0, -13.0);
+      }
+   drawShip(center, rotation, thrust ? flame : NULL);
 }
 
 /************************************************************************
- * DRAW Earth
- * Draw Earth
+ * DRAW Ship
+ * Draw a spaceship on the screen with a flame already picked
  *  INPUT center    The position of the ship
  *        rotation  Which direction it is point
+ *        flame     The tips of the two flame triangles, or NULL
  *************************************************************************/
-void drawEarth(const Position& center, double rotation)
+void drawShip(const Position& center, double rotation, const double * flame)
 {
-   const int * colors[5] = 
+   if (recording())
+      return pRecording->ship(center, rotation, flame);
+
+   Transform transform = rotate(center, rotation);
+
+   static Mesh mesh;
+   if (!mesh.baked)
    {
-      RGB_GREY,  // 0
-      RGB_BLUE,  // 1
-      RGB_GREEN, // 2
-      RGB_TAN,   // 3
-      RGB_WHITE  // 4
-   };
+      // draw the white part of the ship                                               
+      const PT pointsShipWhite[] =
+      { 
+         {0,0},
+         {-3,-9}, {-12,-12}, {-14,-12}, {-13,-7}, {-8,-2}, {-6,3}, {-4,11}, {-4,14}, {-3,16}, {-1,18},
+         {1,18}, {3,16}, {4,14}, {4,11}, {6,3}, {8,-2}, {13,-7}, {14,-12}, {12,-12}, {3,-9}, {-3,-9}
+      };
+      glColor(RGB_LIGHT_GREY);
+      glFan(mesh.triangles, IDENTITY, pointsShipWhite, sizeof(pointsShipWhite) / sizeof(PT));
+
+      // draw the dark part of the ship                                               
+      const PT pointsShipBlack[][4] =
+      {
+         {{-5,-8},  {-12,-11},{-11,-7},{-5,-2}}, // left wing
+         {{ 5,-8},  { 12,-11},{ 11,-7},{ 5,-2}}, // right wing
+         {{ 0,-13}, {-3,11},  {-1,15}, {1,15}},  // left canopy
+         {{ 0,-13}, { 3,11},  { 1,15}, {-1,15}}  // right canopy
+      };
+      glColor(RGB_DEEP_BLUE);
+      for (int iRectangle = 0; iRectangle < 4; iRectangle++)
+         glQuad(mesh.triangles, IDENTITY,
+                pointsShipBlack[iRectangle][0], pointsShipBlack[iRectangle][1],
+                pointsShipBlack[iRectangle][2], pointsShipBlack[iRectangle][3]);
+
+      glBake(mesh);
+   }
+   glDrawInstance(mesh, transform);
 
-   int earth[50][50] =
+   // draw the flame if necessary. It flickers, so it is not part of the
+   // mesh, and goes out behind the ship. From afar it is not worth it.
+   if (flame && detail == DETAIL_FULL)
    {
+      glColor(RGB_RED);
+      for (int i = 0; i < 2; i++)
+      {
+         glVertexPoint(batch.triangles, transform, -3.0, -9.0);
+         glVertexPoint(batch.triangles, transform, flame[i * 2], flame[i * 2 + 1]);
+         glVertexPoint(batch.triangles, transform, 3.0, -9.0);
+      }
+   }
+}
+
+/************************************************************************
+ * EARTH
+ * The picture of the earth, one palette index per cell: 0 is empty,
+ * then blue, green, tan and white. Row 0 is drawn at the bottom.
+ *************************************************************************/
+const int EARTH_SIZE = 50;
+const unsigned char EARTH[EARTH_SIZE][EARTH_SIZE] =
+{
    {0,0,0,0,0, 0,0,0,0,0, 0,0,0,0,0, 0,0,0,0,0, 1,1,1,1,1, 1,1,1,1,1, 0,0,0,0,0, 0,0,0,0,0, 0,0,0,0,0, 0,0,0,0,0,},
    {0,0,0,0,0, 0,0,0,0,0, 0,0,0,0,0, 0,0,1,3,3, 3,2,2,1,1, 1,1,2,2,2, 3,1,1,0,0, 0,0,0,0,0, 0,0,0,0,0, 0,0,0,0,0,},
    {0,0,0,0,0, 0,0,0,0,0, 0,0,0,0,0, 1,1,1,2,2, 2,2,2,2,3, 3,3,3,3,3, 3,3,1,1,1, 0,0,0,0,0, 0,0,0,0,0, 0,0,0,0,0,},
@@ -815,91 +1754,317 @@ void drawEarth(const Position& center, double rotation)
    {0,0,0,0,0, 0,0,0,0,0, 0,0,0,0,0, 1,1,1,1,3, 3,3,1,1,1, 1,1,1,2,2, 2,2,1,1,3, 0,0,0,0,0, 0,0,0,0,0, 0,0,0,0,0,},
    {0,0,0,0,0, 0,0,0,0,0, 0,0,0,0,0, 0,0,1,1,1, 1,2,2,2,2, 1,1,1,1,1, 1,2,3,0,0, 0,0,0,0,0, 0,0,0,0,0, 0,0,0,0,0,},
    {0,0,0,0,0, 0,0,0,0,0, 0,0,0,0,0, 0,0,0,0,0, 0,1,1,1,1, 1,1,1,1,0, 0,0,0,0,0, 0,0,0,0,0, 0,0,0,0,0, 0,0,0,0,0,},
-   };
+};
 
+/************************************************************************
+ * BAKE EARTH
+ * Cover the picture with as few same-colored rectangles as possible:
+ * from each uncovered cell, grow right while the color holds, then grow
+ * up while every cell of the next row matches. The rectangles are
+ * stored as triangles relative to the center of the earth.
+ *************************************************************************/
+static Mesh bakeEarth()
+{
+   const PaletteColor colors[5] = 
+   {
+      RGB_GREY,  // 0
+      RGB_BLUE,  // 1
+      RGB_GREEN, // 2
+      RGB_TAN,   // 3
+      RGB_WHITE  // 4
+   };
    const double SCALE = 2.0;
+   const double OFFSET = -EARTH_SIZE / 2 * SCALE;
 
-   for (int y = 0; y < 50; y++)
-      for (int x = 0; x < 50; x++)
-         if (earth[y][x])
+   bool covered[EARTH_SIZE][EARTH_SIZE] = {};
+   Mesh mesh;
+   for (int y = 0; y < EARTH_SIZE; y++)
+      for (int x = 0; x < EARTH_SIZE; x++)
+      {
+         unsigned char color = EARTH[y][x];
+         if (!color || covered[y][x])
+            continue;
+         assert(color <= 4);
+
+         // grow right
+         int width = 1;
+         while (x + width < EARTH_SIZE &&
+                EARTH[y][x + width] == color && !covered[y][x + width])
+            width++;
+
+         // grow up
+         int height = 1;
+         for (bool grow = true; grow && y + height < EARTH_SIZE; )
          {
-            assert(earth[y][x] > 0 && earth[y][x] <= 4);
-            ColorRect rect = 
-            {
-               static_cast<int>(x * SCALE),
-               static_cast<int>(y * SCALE),
-               
-               static_cast<int>(x * SCALE),
-               static_cast<int>(y * SCALE + SCALE),
-               
-               static_cast<int>(x * SCALE + SCALE),
-               static_cast<int>(y * SCALE + SCALE),
-               
-               static_cast<int>(x * SCALE + SCALE),
-               static_cast<int>(y * SCALE), colors[earth[y][x]]};
-            Position pos;
-            pos.setPixelsX(-25.0 * SCALE);
-            pos.setPixelsY(-25.0 * SCALE);
-            glDrawRect(center, pos, rect, rotation);
+            for (int i = x; grow && i < x + width; i++)
+               grow = EARTH[y + height][i] == color && !covered[y + height][i];
+            if (grow)
+               height++;
          }
 
-   return;
+         for (int j = y; j < y + height; j++)
+            for (int i = x; i < x + width; i++)
+               covered[j][i] = true;
+
+         // two triangles, the same split glQuad() makes
+         glColor(colors[color]);
+         double x0 = OFFSET + x * SCALE;
+         double y0 = OFFSET + y * SCALE;
+         double x1 = x0 + width * SCALE;
+         double y1 = y0 + height * SCALE;
+         glVertexPoint(mesh.triangles, x0, y0);
+         glVertexPoint(mesh.triangles, x0, y1);
+         glVertexPoint(mesh.triangles, x1, y1);
+         glVertexPoint(mesh.triangles, x0, y0);
+         glVertexPoint(mesh.triangles, x1, y1);
+         glVertexPoint(mesh.triangles, x1, y0);
+      }
+   return mesh;
 }
 
 /************************************************************************
- * DRAW STAR
- * Draw a star that twinkles
- *   INPUT  POINT     The position of the beginning of the star
- *          PHASE     The phase of the twinkling
+ * DRAW Earth
+ * Draw Earth
+ *  INPUT center    The position of the ship
+ *        rotation  Which direction it is point
  *************************************************************************/
-void drawStar(const Position& point, unsigned char phase)
+void drawEarth(const Position& center, double rotation)
+{
+   if (recording())
+      return pRecording->part(OP_EARTH, center, rotation);
+
+   countDraw(FAMILY_EARTH);
+   static const Mesh mesh = bakeEarth();
+   glDrawMesh(rotate(center, rotation), mesh);
+}
+
+/************************************************************************
+ * STAR SPRITE
+ * What a star looks like at one phase of its twinkle: up to nine dots
+ * around its center, each with its own color
+ *************************************************************************/
+struct StarSprite
+{
+   int num;
+   struct
+   {
+      float dx;
+      float dy;
+      unsigned char rgba[4];
+   } dots[9];
+};
+
+/************************************************************************
+ * BAKE STAR
+ * Work out the sprite for one phase. Most of the time a star is just a
+ * pale yellow dot, which grows into a bright one and then a cross.
+ *************************************************************************/
+static void bakeStar(StarSprite & sprite, unsigned char phase)
 {
-   // Get ready...
-   glBegin(GL_POINTS);
+   std::vector<Vertex> dots;
 
    // most of the time, it is just a pale yellow dot
    if (phase < 128)
    {
-      glColor3f((GLfloat)0.5 /* red % */, (GLfloat)0.5 /* green % */, (GLfloat)0.0 /* blue % */);
-      glVertex2f((GLfloat)(point.getPixelsX() + 0.0), (GLfloat)(point.getPixelsY() + 0.0));
+      glColor(128, 128, 0);
+      glVertexPoint(dots, 0.0, 0.0);
    }
    // transitions to a bright yellow dot
    else if (phase < 160 || phase > 224)
    {
-      glColor3f((GLfloat)1.0 /* red % */, (GLfloat)1.0 /* green % */, (GLfloat)0.0 /* blue % */);
-      glVertex2f((GLfloat)(point.getPixelsX() + 0.0), (GLfloat)(point.getPixelsY() + 0.0));
+      glColor(255, 255, 0);
+      glVertexPoint(dots, 0.0, 0.0);
    }
    // transitions to a bright yellow dot with pale yellow corners
    else if (phase < 176 || phase > 208)
    {
-      glColor3f((GLfloat)1.0 /* red % */, (GLfloat)1.0 /* green % */, (GLfloat)0.0 /* blue % */);
-      glVertex2f((GLfloat)(point.getPixelsX() + 0.0), (GLfloat)(point.getPixelsY() + 0.0));
-      glColor3f((GLfloat)0.5 /* red % */, (GLfloat)0.5 /* green % */, (GLfloat)0.0 /* blue % */);
-      glVertex2f((GLfloat)(point.getPixelsX() + 1.0), (GLfloat)(point.getPixelsY() + 0.0));
-      glVertex2f((GLfloat)(point.getPixelsX() - 1.0), (GLfloat)(point.getPixelsY() + 0.0));
-      glVertex2f((GLfloat)(point.getPixelsX() + 0.0), (GLfloat)(point.getPixelsY() + 1.0));
-      glVertex2f((GLfloat)(point.getPixelsX() + 0.0), (GLfloat)(point.getPixelsY() - 1.0));
+      glColor(255, 255, 0);
+      glVertexPoint(dots, 0.0, 0.0);
+      glColor(128, 128, 0);
+      glVertexPoint(dots,  1.0,  0.0);
+      glVertexPoint(dots, -1.0,  0.0);
+      glVertexPoint(dots,  0.0,  1.0);
+      glVertexPoint(dots,  0.0, -1.0);
    }
    // the biggest yet
    else
    {
-      glColor3f((GLfloat)1.0 /* red % */, (GLfloat)1.0 /* green % */, (GLfloat)0.0 /* blue % */);
-      glVertex2f((GLfloat)(point.getPixelsX() + 0.0), (GLfloat)(point.getPixelsY() + 0.0));
-      glColor3f((GLfloat)0.7 /* red % */, (GLfloat)0.7 /* green % */, (GLfloat)0.0 /* blue % */);
-      glVertex2f((GLfloat)(point.getPixelsX() + 1.0), (GLfloat)(point.getPixelsY() + 0.0));
-      glVertex2f((GLfloat)(point.getPixelsX() - 1.0), (GLfloat)(point.getPixelsY() + 0.0));
-      glVertex2f((GLfloat)(point.getPixelsX() + 0.0), (GLfloat)(point.getPixelsY() + 1.0));
-      glVertex2f((GLfloat)(point.getPixelsX() + 0.0), (GLfloat)(point.getPixelsY() - 1.0));
-      glColor3f((GLfloat)0.5 /* red % */, (GLfloat)0.5 /* green % */, (GLfloat)0.0 /* blue % */);
-      glVertex2f((GLfloat)(point.getPixelsX() + 2.0), (GLfloat)(point.getPixelsY() + 0.0));
-      glVertex2f((GLfloat)(point.getPixelsX() - 2.0), (GLfloat)(point.getPixelsY() + 0.0));
-      glVertex2f((GLfloat)(point.getPixelsX() + 0.0), (GLfloat)(point.getPixelsY() + 2.0));
-      glVertex2f((GLfloat)(point.getPixelsX() + 0.0), (GLfloat)(point.getPixelsY() - 2.0));
-   }
-
-   // Complete drawing
-   glColor3f((GLfloat)1.0 /* red % */, (GLfloat)1.0 /* green % */, (GLfloat)1.0 /* blue % */);
-   glEnd();
+      glColor(255, 255, 0);
+      glVertexPoint(dots, 0.0, 0.0);
+      glColor(179, 179, 0);
+      glVertexPoint(dots,  1.0,  0.0);
+      glVertexPoint(dots, -1.0,  0.0);
+      glVertexPoint(dots,  0.0,  1.0);
+      glVertexPoint(dots,  0.0, -1.0);
+      glColor(128, 128, 0);
+      glVertexPoint(dots,  2.0,  0.0);
+      glVertexPoint(dots, -2.0,  0.0);
+      glVertexPoint(dots,  0.0,  2.0);
+      glVertexPoint(dots,  0.0, -2.0);
+   }
+
+   assert(dots.size() <= sizeof(sprite.dots) / sizeof(sprite.dots[0]));
+   sprite.num = (int)dots.size();
+   for (int i = 0; i < sprite.num; i++)
+   {
+      sprite.dots[i].dx = dots[i].x;
+      sprite.dots[i].dy = dots[i].y;
+      for (int j = 0; j < 4; j++)
+         sprite.dots[i].rgba[j] = dots[i].rgba[j];
+   }
+}
+
+/************************************************************************
+ * DRAW STAR SPRITE
+ * Add the dots of one star. Each phase's sprite is worked out once, so a
+ * star costs a table lookup and a few copies.
+ *************************************************************************/
+static inline void drawStarSprite(float x, float y, unsigned char phase)
+{
+   static StarSprite sprites[256];
+   static bool baked = false;
+   if (!baked)
+   {
+      for (int i = 0; i < 256; i++)
+         bakeStar(sprites[i], (unsigned char)i);
+      baked = true;
+   }
+
+   const StarSprite & sprite = sprites[phase];
+   for (int j = 0; j < sprite.num; j++)
+   {
+      Vertex vertex = { x + sprite.dots[j].dx, y + sprite.dots[j].dy,
+                        { sprite.dots[j].rgba[0], sprite.dots[j].rgba[1],
+                          sprite.dots[j].rgba[2], sprite.dots[j].rgba[3] } };
+      batch.points.push_back(vertex);
+   }
+}
+
+/************************************************************************
+ * DRAW STARS
+ * Draw a whole field of stars that twinkle
+ *   INPUT  points    Where the stars are
+ *          phases    The phase of each star's twinkling
+ *          num       How many stars there are
+ *************************************************************************/
+void drawStars(const Position * points, const unsigned char * phases, size_t num)
+{
+   if (recording())
+      return pRecording->stars(points, phases, num);
+   countDraw(FAMILY_STARS);
+
+   for (size_t i = 0; i < num; i++)
+      drawStarSprite((float)points[i].getPixelsX(), (float)points[i].getPixelsY(),
+                     phases[i]);
+}
+
+/************************************************************************
+ * DRAW STARS
+ * Draw a whole field of stars already in pixels, as a command list
+ * plays them back
+ *   INPUT  pixels    x then y of each star
+ *          phases    The phase of each star's twinkling
+ *          num       How many stars there are
+ *************************************************************************/
+void drawStars(const float * pixels, const unsigned char * phases, size_t num)
+{
+   countDraw(FAMILY_STARS);
+   for (size_t i = 0; i < num; i++)
+      drawStarSprite(pixels[i * 2], pixels[i * 2 + 1], phases[i]);
+}
+
+/************************************************************************
+ * DRAW TRAIL
+ * Draw where something has been
+ *   INPUT  points    Where it was, oldest first
+ *          num       How many there are
+ *************************************************************************/
+void drawTrail(const Position * points, size_t num)
+{
+   if (recording())
+      return pRecording->trail(points, num);
+
+   // reused from one trail to the next
+   static std::vector<float> pixels;
+   pixels.resize(num * 2);
+   for (size_t i = 0; i < num; i++)
+   {
+      pixels[i * 2]     = (float)points[i].getPixelsX();
+      pixels[i * 2 + 1] = (float)points[i].getPixelsY();
+   }
+   drawTrail(pixels.data(), num);
+}
+
+/************************************************************************
+ * DRAW TRAIL
+ * Draw a trail already in pixels, as a command list plays it back. Each
+ * segment is a little more opaque than the one before it.
+ *   INPUT  pixels    x then y of each position, oldest first
+ *          num       How many there are
+ *************************************************************************/
+void drawTrail(const float * pixels, size_t num)
+{
+   countDraw(FAMILY_TRAILS);
+   glColor(RGB_LIGHT_GREY);
+   for (size_t i = 1; i < num; i++)
+   {
+      batch.rgba[3] = (unsigned char)(255 * i / (num - 1));
+      glVertexPoint(batch.trails, pixels[i * 2 - 2], pixels[i * 2 - 1]);
+      glVertexPoint(batch.trails, pixels[i * 2],     pixels[i * 2 + 1]);
+   }
+   batch.rgba[3] = 255;
+}
+
+/************************************************************************
+ * DRAW HEAT MAP
+ * Draw how crowded the sky is, each level looked up in a ramp from dim
+ * red through orange and yellow to white. The sparser, the more of the
+ * stars show through.
+ *   INPUT  levels    One per pixel, row 0 at the top
+ *          width     Pixels across
+ *          height    Pixels down
+ *************************************************************************/
+void drawHeatMap(const unsigned char * levels, int width, int height)
+{
+   if (recording())
+      return pRecording->heatMap(levels, width, height);
+   countDraw(FAMILY_HEAT_MAP);
+
+   static unsigned char ramp[256][4];
+   static bool baked = false;
+   if (!baked)
+   {
+      for (int level = 0; level < 256; level++)
+      {
+         double t = level / 255.0;
+         ramp[level][0] = (unsigned char)(128.0 + 127.0 * min(t * 3.0, 1.0));
+         ramp[level][1] = (unsigned char)(255.0 * min(max(t * 3.0 - 1.0, 0.0), 1.0));
+         ramp[level][2] = (unsigned char)(255.0 * max(t * 3.0 - 2.0, 0.0));
+         ramp[level][3] = (unsigned char)(level ? 96.0 + 159.0 * t : 0.0);
+      }
+      baked = true;
+   }
+
+   Image & image = batch.image;
+   image.x = -width / 2.0f;
+   image.y = height / 2.0f;
+   image.width = width;
+   image.height = height;
+   image.rgba.resize((size_t)width * height * 4);
+   unsigned char * pixel = image.rgba.data();
+   for (size_t i = 0; i < (size_t)width * height; i++, pixel += 4)
+      memcpy(pixel, ramp[levels[i]], 4);
+}
+
+/************************************************************************
+ * DRAW STAR
+ * Draw a star that twinkles
+ *   INPUT  POINT     The position of the beginning of the star
+ *          PHASE     The phase of the twinkling
+ *************************************************************************/
+void drawStar(const Position& point, unsigned char phase)
+{
+   drawStars(&point, &phase, 1);
 }
 
 
@@ -129,6 +129,14 @@ void drawStarlinkArray(const Position& center, double rotation, const Position&
  *        thrust  Whether the thrusters are on
  *************************************************************************/
 void drawShip(const Position& center, double rotation, bool thrust);
+
+/************************************************************************
+ * DRAW Ship
+ * Draw a spaceship with a given flame, or none
+ *  INPUT flame   The tips of the two flame triangles as x, y, x, y,
+ *                relative to the ship, or NULL when the thrusters are off
+ *************************************************************************/
+void drawShip(const Position& center, double rotation, const double * flame);
 /************************************************************************
  * DRAW Earth
  * Draw Earth
@@ -145,6 +153,193 @@ void drawEarth(const Position& center, double rotation);
 *************************************************************************/
 void drawStar(const Position& point, unsigned char phase);
 
+/************************************************************************
+* DRAW STARS
+* Draw a whole field of stars at once
+*   INPUT  POINTS    The position of each star
+*          PHASES    The phase of each star's twinkling
+*          NUM       How many stars there are
+*************************************************************************/
+void drawStars(const Position * points, const unsigned char * phases, size_t num);
+
+/************************************************************************
+* DRAW STARS
+* Draw a field of stars already in pixels, right away. Used to play
+* back a recorded frame.
+*   INPUT  PIXELS    The x then y of each star
+*          PHASES    The phase of each star's twinkling
+*          NUM       How many stars there are
+*************************************************************************/
+void drawStars(const float * pixels, const unsigned char * phases, size_t num);
+
+/************************************************************************
+* DRAW TRAIL
+* Draw where something has been as one strip of segments, brightest at
+* the newest end and fading out toward the oldest. Trails go under
+* everything but the stars.
+*   INPUT  POINTS    The positions, oldest first
+*          NUM       How many there are
+*************************************************************************/
+void drawTrail(const Position * points, size_t num);
+
+/************************************************************************
+* DRAW TRAIL
+* Draw a trail already in pixels, right away. Used to play back a
+* recorded frame.
+*   INPUT  PIXELS    The x then y of each position, oldest first
+*          NUM       How many there are
+*************************************************************************/
+void drawTrail(const float * pixels, size_t num);
+
+/************************************************************************
+* DRAW HEAT MAP
+* Draw how crowded the sky is, one level per pixel of the screen,
+* centered on the screen. Level 0 is empty and see-through; the rest run
+* from a dim red to white. It goes under everything but the stars.
+*   INPUT  LEVELS    One per pixel, row 0 at the top
+*          WIDTH     Pixels across
+*          HEIGHT    Pixels down
+*************************************************************************/
+void drawHeatMap(const unsigned char * levels, int width, int height);
+
+/************************************************************************
+ * DRAW TEXT
+ * Draw one line of text. ogstream is the usual way to get here.
+ *   INPUT  topLeft   The top left corner of the text
+ *          text      The text to be displayed
+ *          length    How many characters of it, when not all
+ *************************************************************************/
+void drawText(const Position& topLeft, const char* text);
+void drawText(const Position& topLeft, const char* text, size_t length);
+
+/************************************************************************
+ * DETAIL
+ * How much of a part to draw. From far enough away a part is drawn as
+ * the box around it, and from further still as one dot, in its main
+ * color.
+ *************************************************************************/
+enum Detail { DETAIL_POINT, DETAIL_SIMPLE, DETAIL_FULL };
+
+/************************************************************************
+ * DRAW DETAIL
+ * How much of the parts drawn from now on to draw. Back to DETAIL_FULL
+ * at every drawFlush().
+ *************************************************************************/
+void drawDetail(Detail detail);
+
+/************************************************************************
+ * DRAW FLUSH
+ * Nothing drawn above reaches the screen until this is called, once at
+ * the end of every frame. Everything is then sent in a few large calls.
+ *************************************************************************/
+void drawFlush();
+
+/************************************************************************
+ * SET RENDERER
+ * Where drawFlush() sends each frame: the OpenGL window by default, or
+ * a NullRenderer or SoftwareRenderer when there is no window. Pass NULL
+ * to go back to the window.
+ *************************************************************************/
+class Renderer;
+void setRenderer(Renderer * pRenderer);
+
+/************************************************************************
+ * SET PART SPRITES
+ * Draw the parts of satellites as pictures painted ahead of time, one
+ * per way they can be turned, each copy one textured quad. Otherwise,
+ * and at first, they are drawn as their shapes. Every part is painted
+ * into the atlas when this is turned on, so call it on the drawing
+ * thread before the first frame.
+ *************************************************************************/
+void setPartSprites(bool sprites);
+
+/************************************************************************
+ * RECORD INTO
+ * The draw* functions above do not draw; they record into a command
+ * list that drawFlush() plays back. By default that is the frame's own
+ * list, which only the drawing thread, the first to draw or flush, may
+ * use. A worker thread must record into a list of its own, to be handed
+ * to drawCommands() on the drawing thread. NULL draws right away, and
+ * is also for the drawing thread alone.
+ *   INPUT  pList     Where this thread's draw calls go from now on
+ *   OUTPUT <return>  Where they went before
+ *************************************************************************/
+class CommandList;
+CommandList * recordInto(CommandList * pList);
+
+/************************************************************************
+ * DRAW COMMANDS
+ * Add a recorded list to this frame, after everything recorded so far
+ *************************************************************************/
+void drawCommands(const CommandList & list);
+
+/************************************************************************
+ * LAST FRAME COMMANDS
+ * Everything the last frame drew, as played back by drawFlush(), for
+ * saving or comparing against another build
+ *************************************************************************/
+const CommandList & lastFrameCommands();
+
+/************************************************************************
+ * LAST FRAME STATE CHANGES
+ * How many times the parts of the last frame changed color or primitive:
+ * as drawn one part at a time, and as actually sent, sorted
+ *************************************************************************/
+struct StateChanges
+{
+   size_t unsorted;
+   size_t sorted;
+};
+StateChanges lastFrameStateChanges();
+
+/************************************************************************
+ * RENDER STATS
+ * What the last frame cost, counted as it was drawn: the draw* calls
+ * that reached it, the vertices and sprites sent to the renderer, the
+ * calls to rotate(), how often the parts changed color as sent, how
+ * many objects the caller left out, and the milliseconds spent in each
+ * family of draw* calls. Parts include copying them into place, and
+ * render is the renderer itself. Build with NO_RENDER_STATS to take
+ * the counting out entirely; everything then reads 0.
+ *************************************************************************/
+#ifdef NO_RENDER_STATS
+const bool RENDER_STATS = false;
+#else
+const bool RENDER_STATS = true;
+#endif
+
+enum DrawFamily
+{
+   FAMILY_STARS, FAMILY_HEAT_MAP, FAMILY_EARTH, FAMILY_TRAILS,
+   FAMILY_PARTS, FAMILY_TEXT, FAMILY_RENDER, FAMILY_COUNT
+};
+
+struct RenderStats
+{
+   size_t drawCalls;
+   size_t vertices;
+   size_t sprites;
+   size_t rotations;
+   size_t colorChanges;
+   size_t culled;
+   double milliseconds[FAMILY_COUNT];
+};
+RenderStats lastFrameStats();
+
+/************************************************************************
+ * COUNT CULLED
+ * Add to this frame's count of objects left out before drawing, since
+ * only the caller knows. Call it on the drawing thread before drawFlush().
+ *************************************************************************/
+void countCulled(size_t num);
+
+/************************************************************************
+ * DRAW STATS
+ * Show the last frame's stats as text, through ogstream
+ *   INPUT  topLeft   The top left corner of the text
+ *************************************************************************/
+void drawStats(const Position& topLeft);
+
 /******************************************************************
  * RANDOM
  * This function generates a random number.  The user specifies